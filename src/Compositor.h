@@ -0,0 +1,138 @@
+#ifndef COMPOSITOR_H
+#define COMPOSITOR_H
+
+#include <stdint.h>
+#include "WS2812.h"
+#include "Surface.h"
+#include "Framebuffer.h"
+
+// One compositor layer: colours plus a coverage bit per pixel, and the set
+// of rows changed since it was last composed. Pixels not covered are
+// transparent.
+template <int Width, int Height>
+class Layer : public Surface<Layer<Width, Height>, Width, Height> {
+public:
+    static_assert(Width <= 32 && Height <= 32, "Coverage and dirty rows are 32-bit masks");
+
+    bool ready() const { return true; }
+
+    // Write one pixel without any checks; (x, y) must be on the layer
+    void put(int x, int y, ws2812_pixel_t c) {
+        pixels_[y][x] = c;
+        coverage_[y] |= 0x80000000u >> x;
+        dirty_ |= 1u << y;
+    }
+
+    // Make the whole layer transparent, marking the rows it covered
+    void clear() {
+        for (int y = 0; y < Height; y++) {
+            if (coverage_[y]) {
+                coverage_[y] = 0;
+                dirty_ |= 1u << y;
+            }
+        }
+    }
+
+    // Hidden layers keep their contents but are skipped when composing
+    void set_visible(bool visible) {
+        if (visible != visible_) {
+            visible_ = visible;
+            for (int y = 0; y < Height; y++) {
+                if (coverage_[y]) {
+                    dirty_ |= 1u << y;
+                }
+            }
+        }
+    }
+
+    bool visible() const { return visible_; }
+
+    // Covered columns of row y, bit 31 is column 0
+    uint32_t coverage(int y) const { return coverage_[y]; }
+
+    ws2812_pixel_t pixel(int x, int y) const { return pixels_[y][x]; }
+
+    // Rows changed since the last take_dirty(), bit n is row n
+    uint32_t take_dirty() {
+        uint32_t dirty = dirty_;
+        dirty_ = 0;
+        return dirty;
+    }
+
+private:
+    ws2812_pixel_t pixels_[Height][Width] = {};
+    uint32_t coverage_[Height] = {};
+    uint32_t dirty_ = 0;
+    bool visible_ = true;
+};
+
+// Stack of Count layers over a Framebuffer; layer 0 is at the bottom.
+// Draw static content into its layer once and only redraw layers whose
+// content moves. compose() rebuilds just the rows some layer changed,
+// taking each pixel from the topmost visible layer covering it, or black.
+template <class Layout, int Count>
+class Compositor {
+public:
+    using LayerType = Layer<Layout::width, Layout::height>;
+
+    explicit Compositor(Framebuffer<Layout> &fb) : fb_(fb) {}
+
+    LayerType &layer(int index) { return layers_[index]; }
+
+    // Clear every layer, e.g. when a game starts
+    void reset() {
+        for (int i = 0; i < Count; i++) {
+            layers_[i].clear();
+            layers_[i].set_visible(true);
+        }
+        invalidate();
+    }
+
+    // Recompose everything on the next compose(), for when something else
+    // has drawn on the framebuffer
+    void invalidate() { full_ = true; }
+
+    // Write the changed rows to the framebuffer; returns the rows written
+    uint32_t compose() {
+        uint32_t dirty = full_ ? ~0u : 0;
+        full_ = false;
+        for (int i = 0; i < Count; i++) {
+            dirty |= layers_[i].take_dirty();
+        }
+        if (!fb_.ready()) return 0;
+
+        const uint32_t columns = ~0u << (32 - Layout::width);
+        const ws2812_pixel_t black = {0, 0, 0};
+        for (int y = 0; y < Layout::height; y++) {
+            if (!(dirty & (1u << y))) continue;
+
+            // Walk down from the top layer; each one fills the columns no
+            // layer above it has covered
+            uint32_t open = columns;
+            for (int i = Count - 1; i >= 0 && open; i--) {
+                const LayerType &layer = layers_[i];
+                if (!layer.visible()) continue;
+                uint32_t mask = layer.coverage(y) & open;
+                open &= ~mask;
+                while (mask) {
+                    int x = __builtin_clz(mask);
+                    fb_.put(x, y, layer.pixel(x, y));
+                    mask &= ~(0x80000000u >> x);
+                }
+            }
+            while (open) {
+                int x = __builtin_clz(open);
+                fb_.put(x, y, black);
+                open &= ~(0x80000000u >> x);
+            }
+        }
+        return dirty & (Layout::height == 32 ? ~0u : (1u << Layout::height) - 1);
+    }
+
+private:
+    Framebuffer<Layout> &fb_;
+    LayerType layers_[Count];
+    bool full_ = true;
+};
+
+#endif // COMPOSITOR_H
@@ -0,0 +1,110 @@
+#ifndef FIXED_POINT_H
+#define FIXED_POINT_H
+
+#include <stdint.h>
+#include <limits>
+
+// Signed fixed-point number with Frac fractional bits stored in T, with
+// intermediate results computed in Wide. The ESP32-C3 has no FPU, so game
+// state uses this instead of float. Arithmetic saturates at the range of T
+// rather than wrapping.
+//
+// Converting from double is constexpr and meant for constants, e.g.
+// static constexpr q8_8 GRAVITY(0.15); at run time it would pull in the
+// soft-float routines this type exists to avoid.
+template <typename T, typename Wide, int Frac>
+class Fixed {
+public:
+    static_assert(sizeof(Wide) >= 2 * sizeof(T), "Wide must hold a full product");
+
+    static constexpr int frac_bits = Frac;
+    static constexpr T one_raw = (T)1 << Frac;
+
+    constexpr Fixed() : raw_(0) {}
+    constexpr Fixed(int value) : raw_(saturate((Wide)value * one_raw)) {}
+    explicit constexpr Fixed(double value)
+        : raw_(saturate((Wide)(value * one_raw + (value < 0 ? -0.5 : 0.5)))) {}
+
+    static constexpr Fixed from_raw(T raw) {
+        Fixed f;
+        f.raw_ = raw;
+        return f;
+    }
+
+    // num / den without going through floating point; den must not be 0
+    static constexpr Fixed ratio(int32_t num, int32_t den) {
+        return from_raw(saturate((Wide)num * one_raw / den));
+    }
+
+    static constexpr Fixed max() { return from_raw(std::numeric_limits<T>::max()); }
+    static constexpr Fixed min() { return from_raw(std::numeric_limits<T>::min()); }
+
+    constexpr T raw() const { return raw_; }
+
+    // Integer part, truncated toward zero like a cast from float
+    constexpr int to_int() const { return raw_ / one_raw; }
+
+    // Largest integer not above the value
+    constexpr int floor() const { return raw_ >> Frac; }
+
+    // Nearest integer, halves away from zero
+    constexpr int round() const {
+        return raw_ >= 0 ? (int)(((Wide)raw_ + one_raw / 2) >> Frac)
+                         : -(int)(((Wide)-raw_ + one_raw / 2) >> Frac);
+    }
+
+    // value * this, truncated toward zero, e.g. to scale a colour channel
+    constexpr int scale(int value) const { return (int)((Wide)value * raw_ / one_raw); }
+
+    constexpr Fixed operator-() const { return from_raw(saturate(-(Wide)raw_)); }
+
+    friend constexpr Fixed operator+(Fixed a, Fixed b) { return from_raw(saturate((Wide)a.raw_ + b.raw_)); }
+    friend constexpr Fixed operator-(Fixed a, Fixed b) { return from_raw(saturate((Wide)a.raw_ - b.raw_)); }
+    friend constexpr Fixed operator*(Fixed a, Fixed b) {
+        return from_raw(saturate(((Wide)a.raw_ * b.raw_) >> Frac));
+    }
+    // Division by zero saturates towards the sign of the dividend
+    friend constexpr Fixed operator/(Fixed a, Fixed b) {
+        return b.raw_ ? from_raw(saturate((Wide)a.raw_ * one_raw / b.raw_))
+                      : (a.raw_ < 0 ? min() : max());
+    }
+
+    Fixed &operator+=(Fixed b) { return *this = *this + b; }
+    Fixed &operator-=(Fixed b) { return *this = *this - b; }
+    Fixed &operator*=(Fixed b) { return *this = *this * b; }
+    Fixed &operator/=(Fixed b) { return *this = *this / b; }
+
+    friend constexpr bool operator==(Fixed a, Fixed b) { return a.raw_ == b.raw_; }
+    friend constexpr bool operator!=(Fixed a, Fixed b) { return a.raw_ != b.raw_; }
+    friend constexpr bool operator<(Fixed a, Fixed b) { return a.raw_ < b.raw_; }
+    friend constexpr bool operator<=(Fixed a, Fixed b) { return a.raw_ <= b.raw_; }
+    friend constexpr bool operator>(Fixed a, Fixed b) { return a.raw_ > b.raw_; }
+    friend constexpr bool operator>=(Fixed a, Fixed b) { return a.raw_ >= b.raw_; }
+
+private:
+    static constexpr T saturate(Wide value) {
+        return value > std::numeric_limits<T>::max() ? std::numeric_limits<T>::max()
+             : value < std::numeric_limits<T>::min() ? std::numeric_limits<T>::min()
+             : (T)value;
+    }
+
+    T raw_;
+};
+
+// Positions and velocities on the 16x16 matrix: +-128 in 1/256 steps
+using q8_8 = Fixed<int16_t, int32_t, 8>;
+// Ratios and progress where more range or precision is needed
+using q16_16 = Fixed<int32_t, int64_t, 16>;
+
+template <typename F>
+constexpr F fixed_clamp(F value, F lo, F hi) {
+    return value < lo ? lo : value > hi ? hi : value;
+}
+
+// a + (b - a) * t; t = 0 gives a, t = 1 gives b
+template <typename F>
+constexpr F fixed_lerp(F a, F b, F t) {
+    return a + (b - a) * t;
+}
+
+#endif // FIXED_POINT_H
@@ -0,0 +1,164 @@
+#ifndef FONT_H
+#define FONT_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include "Sprite.h"
+
+// 3x5 bitmap font covering ASCII ' ' to 'Z'; lowercase is drawn as
+// uppercase. Glyphs are drawn from ASCII art at compile time into sprite
+// rows, so drawing a character is one 5-row blit.
+#define FONT_WIDTH 3
+#define FONT_HEIGHT 5
+#define FONT_ADVANCE 4      // Glyph plus one column of spacing
+#define FONT_FIRST ' '
+#define FONT_LAST 'Z'
+
+struct FontGlyph {
+    uint16_t rows[FONT_HEIGHT];
+};
+
+// Five rows of three characters, '#' for a lit pixel
+constexpr FontGlyph font_glyph_from_art(const char (&art)[FONT_WIDTH * FONT_HEIGHT + 1]) {
+    FontGlyph glyph{};
+    for (int y = 0; y < FONT_HEIGHT; y++) {
+        for (int x = 0; x < FONT_WIDTH; x++) {
+            if (art[y * FONT_WIDTH + x] == '#') {
+                glyph.rows[y] |= 0x8000 >> x;
+            }
+        }
+    }
+    return glyph;
+}
+
+#define FONT_GLYPH(r0, r1, r2, r3, r4) font_glyph_from_art(r0 r1 r2 r3 r4)
+
+constexpr FontGlyph FONT_3X5[] = {
+    FONT_GLYPH("...", "...", "...", "...", "..."),  // ' '
+    FONT_GLYPH(".#.", ".#.", ".#.", "...", ".#."),  // '!'
+    FONT_GLYPH("#.#", "#.#", "...", "...", "..."),  // '"'
+    FONT_GLYPH("#.#", "###", "#.#", "###", "#.#"),  // '#'
+    FONT_GLYPH(".##", "##.", ".#.", ".##", "##."),  // '$'
+    FONT_GLYPH("#.#", "..#", ".#.", "#..", "#.#"),  // '%'
+    FONT_GLYPH(".#.", "#.#", ".#.", "#.#", ".##"),  // '&'
+    FONT_GLYPH(".#.", ".#.", "...", "...", "..."),  // '\''
+    FONT_GLYPH("..#", ".#.", ".#.", ".#.", "..#"),  // '('
+    FONT_GLYPH("#..", ".#.", ".#.", ".#.", "#.."),  // ')'
+    FONT_GLYPH("...", "#.#", ".#.", "#.#", "..."),  // '*'
+    FONT_GLYPH("...", ".#.", "###", ".#.", "..."),  // '+'
+    FONT_GLYPH("...", "...", "...", ".#.", "#.."),  // ','
+    FONT_GLYPH("...", "...", "###", "...", "..."),  // '-'
+    FONT_GLYPH("...", "...", "...", "...", ".#."),  // '.'
+    FONT_GLYPH("..#", "..#", ".#.", "#..", "#.."),  // '/'
+    FONT_GLYPH("###", "#.#", "#.#", "#.#", "###"),  // '0'
+    FONT_GLYPH(".#.", "##.", ".#.", ".#.", "###"),  // '1'
+    FONT_GLYPH("###", "..#", "###", "#..", "###"),  // '2'
+    FONT_GLYPH("###", "..#", ".##", "..#", "###"),  // '3'
+    FONT_GLYPH("#.#", "#.#", "###", "..#", "..#"),  // '4'
+    FONT_GLYPH("###", "#..", "###", "..#", "###"),  // '5'
+    FONT_GLYPH("###", "#..", "###", "#.#", "###"),  // '6'
+    FONT_GLYPH("###", "..#", ".#.", ".#.", ".#."),  // '7'
+    FONT_GLYPH("###", "#.#", "###", "#.#", "###"),  // '8'
+    FONT_GLYPH("###", "#.#", "###", "..#", "###"),  // '9'
+    FONT_GLYPH("...", ".#.", "...", ".#.", "..."),  // ':'
+    FONT_GLYPH("...", ".#.", "...", ".#.", "#.."),  // ';'
+    FONT_GLYPH("..#", ".#.", "#..", ".#.", "..#"),  // '<'
+    FONT_GLYPH("...", "###", "...", "###", "..."),  // '='
+    FONT_GLYPH("#..", ".#.", "..#", ".#.", "#.."),  // '>'
+    FONT_GLYPH("###", "..#", ".##", "...", ".#."),  // '?'
+    FONT_GLYPH("###", "#.#", "###", "#..", "###"),  // '@'
+    FONT_GLYPH(".#.", "#.#", "###", "#.#", "#.#"),  // 'A'
+    FONT_GLYPH("##.", "#.#", "##.", "#.#", "##."),  // 'B'
+    FONT_GLYPH(".##", "#..", "#..", "#..", ".##"),  // 'C'
+    FONT_GLYPH("##.", "#.#", "#.#", "#.#", "##."),  // 'D'
+    FONT_GLYPH("###", "#..", "##.", "#..", "###"),  // 'E'
+    FONT_GLYPH("###", "#..", "##.", "#..", "#.."),  // 'F'
+    FONT_GLYPH(".##", "#..", "#.#", "#.#", ".##"),  // 'G'
+    FONT_GLYPH("#.#", "#.#", "###", "#.#", "#.#"),  // 'H'
+    FONT_GLYPH("###", ".#.", ".#.", ".#.", "###"),  // 'I'
+    FONT_GLYPH("..#", "..#", "..#", "#.#", ".#."),  // 'J'
+    FONT_GLYPH("#.#", "#.#", "##.", "#.#", "#.#"),  // 'K'
+    FONT_GLYPH("#..", "#..", "#..", "#..", "###"),  // 'L'
+    FONT_GLYPH("#.#", "###", "###", "#.#", "#.#"),  // 'M'
+    FONT_GLYPH("##.", "#.#", "#.#", "#.#", "#.#"),  // 'N'
+    FONT_GLYPH(".#.", "#.#", "#.#", "#.#", ".#."),  // 'O'
+    FONT_GLYPH("##.", "#.#", "##.", "#..", "#.."),  // 'P'
+    FONT_GLYPH(".#.", "#.#", "#.#", "##.", ".##"),  // 'Q'
+    FONT_GLYPH("##.", "#.#", "##.", "#.#", "#.#"),  // 'R'
+    FONT_GLYPH(".##", "#..", ".#.", "..#", "##."),  // 'S'
+    FONT_GLYPH("###", ".#.", ".#.", ".#.", ".#."),  // 'T'
+    FONT_GLYPH("#.#", "#.#", "#.#", "#.#", "###"),  // 'U'
+    FONT_GLYPH("#.#", "#.#", "#.#", "#.#", ".#."),  // 'V'
+    FONT_GLYPH("#.#", "#.#", "###", "###", "#.#"),  // 'W'
+    FONT_GLYPH("#.#", "#.#", ".#.", "#.#", "#.#"),  // 'X'
+    FONT_GLYPH("#.#", "#.#", ".#.", ".#.", ".#."),  // 'Y'
+    FONT_GLYPH("###", "..#", ".#.", "#..", "###"),  // 'Z'
+};
+
+static_assert(sizeof(FONT_3X5) / sizeof(FONT_3X5[0]) == FONT_LAST - FONT_FIRST + 1,
+              "Font atlas must cover FONT_FIRST to FONT_LAST");
+
+#undef FONT_GLYPH
+
+// Sprite for character c; characters outside the font draw as '?'
+inline Sprite font_glyph(char c) {
+    if (c >= 'a' && c <= 'z') {
+        c -= 'a' - 'A';
+    }
+    if (c < FONT_FIRST || c > FONT_LAST) {
+        c = '?';
+    }
+    return {FONT_WIDTH, FONT_HEIGHT, FONT_3X5[c - FONT_FIRST].rows};
+}
+
+// Width of text in pixels, without trailing spacing
+inline int text_width(const char *text) {
+    int count = 0;
+    while (text[count]) {
+        count++;
+    }
+    return count ? count * FONT_ADVANCE - 1 : 0;
+}
+
+// Draw up to max_chars characters of text with the top left corner of the
+// first at (x, y); characters entirely off the surface are skipped.
+// Returns the x position after the last character drawn.
+template <class Target>
+int draw_text(Target &target, int x, int y, const char *text, ws2812_pixel_t colour,
+              int max_chars = -1) {
+    for (int i = 0; text[i] && i != max_chars && x < Target::width; i++, x += FONT_ADVANCE) {
+        if (x > -FONT_WIDTH && text[i] != ' ') {
+            blit(target, font_glyph(text[i]), x, y, colour);
+        }
+    }
+    return x;
+}
+
+// Draw text horizontally centred on row y
+template <class Target>
+void draw_text_centered(Target &target, int y, const char *text, ws2812_pixel_t colour) {
+    draw_text(target, (Target::width - text_width(text)) / 2, y, text, colour);
+}
+
+// Draw value in decimal horizontally centred on row y
+template <class Target>
+void draw_number_centered(Target &target, int y, int value, ws2812_pixel_t colour) {
+    char text[12];
+    snprintf(text, sizeof(text), "%d", value);
+    draw_text_centered(target, y, text, colour);
+}
+
+// Pixels text travels to scroll fully across a surface of the given width
+inline int marquee_span(const char *text, int width) {
+    return text_width(text) + width;
+}
+
+// Draw text scrolled offset pixels into a marquee: it enters from the right
+// edge at offset 0 and has left the surface at marquee_span(), then repeats
+template <class Target>
+void draw_marquee(Target &target, int y, const char *text, int offset, ws2812_pixel_t colour) {
+    int span = marquee_span(text, Target::width);
+    draw_text(target, Target::width - offset % span, y, text, colour);
+}
+
+#endif // FONT_H
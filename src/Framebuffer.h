@@ -0,0 +1,32 @@
+#ifndef FRAMEBUFFER_H
+#define FRAMEBUFFER_H
+
+#include <stdint.h>
+#include "WS2812.h"
+#include "Surface.h"
+
+// 2D drawing surface over a strip's pixel buffer, addressed through a
+// LedLayout. Pixels go straight to the strip with ws2812_put().
+template <class Layout>
+class Framebuffer : public Surface<Framebuffer<Layout>, Layout::width, Layout::height> {
+public:
+    explicit Framebuffer(ws2812_t *strip = nullptr) : strip_(strip) {}
+
+    ws2812_t *strip() const { return strip_; }
+
+    bool ready() const { return strip_ != nullptr; }
+
+    void clear() {
+        ws2812_clear(strip_);
+    }
+
+    // Write one pixel without any checks; (x, y) must be on the matrix
+    void put(int x, int y, ws2812_pixel_t c) {
+        ws2812_put(strip_, Layout::index(x, y), c.r, c.g, c.b);
+    }
+
+private:
+    ws2812_t *strip_;
+};
+
+#endif // FRAMEBUFFER_H
@@ -0,0 +1,94 @@
+#ifndef LED_LAYOUT_H
+#define LED_LAYOUT_H
+
+#include <stdint.h>
+
+// How the LED chain runs along each physical row
+enum class LedWiring : uint8_t {
+    Progressive,    // Every row starts at the same edge
+    Serpentine,     // Every other row runs back the other way
+};
+
+// Compile-time mapping from logical (x, y) to the LED's index in the chain.
+// Logical coordinates are mirrored horizontally first, then rotated
+// clockwise by Rotation degrees onto the physical panel, which is wired
+// row by row from its top left LED. Bands is the number of outputs the rows
+// are split across; serpentine rows restart their direction in each band.
+//
+// The whole mapping is folded into a Width * Height table at compile time,
+// so addressing a pixel is one load.
+template <int Width, int Height, LedWiring Wiring, int Rotation = 0,
+          bool Mirror = false, int Bands = 1>
+struct LedLayout {
+    static_assert(Rotation == 0 || Rotation == 90 || Rotation == 180 || Rotation == 270,
+                  "Rotation must be 0, 90, 180 or 270");
+    static_assert(Rotation % 180 == 0 || Width == Height,
+                  "90 and 270 degree rotation need a square matrix");
+    static_assert(Bands > 0 && Height % Bands == 0, "Bands must divide Height");
+    static_assert(Width * Height <= 65536, "Matrix too large for 16-bit indices");
+
+    static constexpr int width = Width;
+    static constexpr int height = Height;
+    static constexpr int count = Width * Height;
+
+    // Chain index of logical pixel (x, y), which must be in range
+    static constexpr uint16_t map(int x, int y) {
+        if (Mirror) {
+            x = Width - 1 - x;
+        }
+
+        int px = x;
+        int py = y;
+        if (Rotation == 90) {
+            px = Width - 1 - y;
+            py = x;
+        } else if (Rotation == 180) {
+            px = Width - 1 - x;
+            py = Height - 1 - y;
+        } else if (Rotation == 270) {
+            px = y;
+            py = Height - 1 - x;
+        }
+
+        int row = py % (Height / Bands);
+        if (Wiring == LedWiring::Serpentine && (row & 1)) {
+            px = Width - 1 - px;
+        }
+        return (uint16_t)(py * Width + px);
+    }
+
+    struct Table {
+        uint16_t index[Width * Height];
+    };
+
+    static constexpr Table build() {
+        Table table{};
+        for (int y = 0; y < Height; y++) {
+            for (int x = 0; x < Width; x++) {
+                table.index[y * Width + x] = map(x, y);
+            }
+        }
+        return table;
+    }
+
+    static constexpr Table table = build();
+
+    // Chain index of (x, y) without bounds checking
+    static inline uint16_t index(int x, int y) {
+        return table.index[y * Width + x];
+    }
+
+    // Chain index of (x, y), or -1 when it is off the matrix
+    static inline int index_checked(int x, int y) {
+        if ((unsigned)x >= (unsigned)Width || (unsigned)y >= (unsigned)Height) {
+            return -1;
+        }
+        return table.index[y * Width + x];
+    }
+};
+
+template <int Width, int Height, LedWiring Wiring, int Rotation, bool Mirror, int Bands>
+constexpr typename LedLayout<Width, Height, Wiring, Rotation, Mirror, Bands>::Table
+    LedLayout<Width, Height, Wiring, Rotation, Mirror, Bands>::table;
+
+#endif // LED_LAYOUT_H
@@ -0,0 +1,66 @@
+#ifndef SPRITE_H
+#define SPRITE_H
+
+#include <stdint.h>
+#include "Surface.h"
+
+// 1-bpp sprite, up to 16 pixels wide: one uint16_t per row, bit 15 is the
+// leftmost column
+struct Sprite {
+    uint8_t width;
+    uint8_t height;
+    const uint16_t *rows;
+};
+
+// Colours for a sprite's clear and set bits. The entry at index key is not
+// drawn, so the background shows through; -1 draws both.
+struct SpritePalette {
+    ws2812_pixel_t colour[2];     // Clear bits, set bits
+    int8_t key;
+};
+
+// Draw sprite on any Surface with its top left corner at (x, y). Rows are
+// clipped once, then each row is shifted into place and masked against the
+// surface, and only the columns left in the mask are written.
+template <class Target>
+void blit_palette(Target &target, const Sprite &sprite, int x, int y,
+                  const SpritePalette &palette) {
+    static_assert(Target::width <= 32, "Sprite rows are placed in 32-bit words");
+
+    if (!target.ready() || x <= -16 || x >= Target::width) return;
+
+    int first = y < 0 ? -y : 0;
+    int last = sprite.height;
+    if (last > Target::height - y) {
+        last = Target::height - y;
+    }
+
+    // Bit 31 is matrix column 0
+    const uint32_t visible = ~0u << (32 - Target::width);
+    uint32_t shape = (uint32_t)(uint16_t)(0xFFFFu << (16 - sprite.width)) << 16;
+    shape = (x >= 0 ? shape >> x : shape << -x) & visible;
+
+    for (int row = first; row < last; row++) {
+        uint32_t bits = (uint32_t)sprite.rows[row] << 16;
+        bits = (x >= 0 ? bits >> x : bits << -x) & shape;
+
+        for (int index = 0; index < 2; index++) {
+            if (index == palette.key) continue;
+            uint32_t mask = index ? bits : shape & ~bits;
+            while (mask) {
+                int column = __builtin_clz(mask);
+                target.put(column, y + row, palette.colour[index]);
+                mask &= ~(0x80000000u >> column);
+            }
+        }
+    }
+}
+
+// Draw the set bits of sprite in one colour, leaving clear bits transparent
+template <class Target>
+void blit(Target &target, const Sprite &sprite, int x, int y, ws2812_pixel_t colour) {
+    SpritePalette palette = {{{0, 0, 0}, colour}, 0};
+    blit_palette(target, sprite, x, y, palette);
+}
+
+#endif // SPRITE_H
@@ -0,0 +1,74 @@
+#ifndef SURFACE_H
+#define SURFACE_H
+
+#include <stdint.h>
+#include "WS2812.h"
+
+// Drawing primitives shared by everything that can be drawn on. Derived
+// provides ready() and an unchecked put(x, y, colour); every primitive here
+// clips against the surface once, then calls put() in a tight loop.
+template <class Derived, int Width, int Height>
+class Surface {
+public:
+    static constexpr int width = Width;
+    static constexpr int height = Height;
+
+    // Write one pixel, ignoring coordinates off the surface
+    void set(int x, int y, ws2812_pixel_t c) {
+        if (self().ready() && (unsigned)x < (unsigned)Width && (unsigned)y < (unsigned)Height) {
+            self().put(x, y, c);
+        }
+    }
+
+    // Horizontal run of w pixels starting at (x, y)
+    void hline(int x, int y, int w, ws2812_pixel_t c) {
+        if (!self().ready() || (unsigned)y >= (unsigned)Height || !clip(x, w, Width)) return;
+        for (int end = x + w; x < end; x++) {
+            self().put(x, y, c);
+        }
+    }
+
+    // Vertical run of h pixels starting at (x, y)
+    void vline(int x, int y, int h, ws2812_pixel_t c) {
+        if (!self().ready() || (unsigned)x >= (unsigned)Width || !clip(y, h, Height)) return;
+        for (int end = y + h; y < end; y++) {
+            self().put(x, y, c);
+        }
+    }
+
+    void fill_rect(int x, int y, int w, int h, ws2812_pixel_t c) {
+        if (!self().ready() || !clip(x, w, Width) || !clip(y, h, Height)) return;
+        for (int end = y + h; y < end; y++) {
+            for (int i = x; i < x + w; i++) {
+                self().put(i, y, c);
+            }
+        }
+    }
+
+    // One pixel wide outline
+    void rect(int x, int y, int w, int h, ws2812_pixel_t c) {
+        if (w <= 0 || h <= 0) return;
+        hline(x, y, w, c);
+        hline(x, y + h - 1, w, c);
+        vline(x, y + 1, h - 2, c);
+        vline(x + w - 1, y + 1, h - 2, c);
+    }
+
+protected:
+    // Trim the run [start, start + len) to [0, limit); false if nothing is left
+    static bool clip(int &start, int &len, int limit) {
+        if (start < 0) {
+            len += start;
+            start = 0;
+        }
+        if (len > limit - start) {
+            len = limit - start;
+        }
+        return len > 0;
+    }
+
+private:
+    Derived &self() { return static_cast<Derived &>(*this); }
+};
+
+#endif // SURFACE_H
@@ -0,0 +1,116 @@
+#ifndef TRANSITIONS_H
+#define TRANSITIONS_H
+
+#include <stdint.h>
+#include "WS2812.h"
+
+// Screen transitions driven by precomputed fields: one byte per pixel that
+// orders when the pixel is reached. The fields are built at compile time,
+// so drawing a frame of a transition is one compare per pixel and no
+// floating point (the ESP32-C3 has no FPU).
+template <int Width, int Height>
+struct TransitionField {
+    uint8_t value[Width * Height];   // Row-major, logical coordinates
+    uint8_t max;                     // Largest value in the field
+};
+
+// Integer square root, rounded to nearest
+constexpr uint32_t transition_isqrt(uint32_t n) {
+    uint32_t root = 0;
+    while ((root + 1) * (root + 1) <= n) {
+        root++;
+    }
+    return (n - root * root > root) ? root + 1 : root;
+}
+
+// Angle of (dx, dy) clockwise from straight up, in 1/256ths of a turn
+constexpr int transition_angle(double dx, double dy) {
+    // atan(z) ~ z * (pi/4 + 0.273 * (1 - |z|)) for |z| <= 1, within 0.005 rad
+    double ax = dx < 0 ? -dx : dx;
+    double ay = dy < 0 ? -dy : dy;
+    if (ax == 0 && ay == 0) return 0;
+    double z = ax < ay ? ax / ay : ay / ax;
+    double a = z * (0.7853981634 + 0.273 * (1 - z));     // radians, 0 .. pi/4
+    if (ax > ay) a = 1.5707963268 - a;                   // from the vertical axis
+    // Quadrants, with dy pointing down the screen
+    if (dy > 0) a = 3.1415926536 - a;
+    if (dx < 0) a = 6.2831853072 - a;
+    int angle = (int)(a * 256 / 6.2831853072 + 0.5);
+    return angle & 255;
+}
+
+// Distance from the centre, in 1/16ths of a pixel
+template <int Width, int Height>
+constexpr TransitionField<Width, Height> transition_radial() {
+    TransitionField<Width, Height> field{};
+    for (int y = 0; y < Height; y++) {
+        for (int x = 0; x < Width; x++) {
+            // Doubled offsets keep the half-pixel centre integral
+            int dx = 2 * x - (Width - 1);
+            int dy = 2 * y - (Height - 1);
+            uint32_t d = transition_isqrt((uint32_t)(dx * dx + dy * dy) * 64);
+            field.value[y * Width + x] = (uint8_t)d;
+            if (d > field.max) field.max = (uint8_t)d;
+        }
+    }
+    return field;
+}
+
+// Diagonal sweep from the top left corner
+template <int Width, int Height>
+constexpr TransitionField<Width, Height> transition_wipe() {
+    TransitionField<Width, Height> field{};
+    for (int y = 0; y < Height; y++) {
+        for (int x = 0; x < Width; x++) {
+            field.value[y * Width + x] = (uint8_t)((x + y) * 255 / (Width + Height - 2));
+        }
+    }
+    field.max = 255;
+    return field;
+}
+
+// Spiral out from the centre, Turns times round, starting straight up
+template <int Width, int Height, int Turns>
+constexpr TransitionField<Width, Height> transition_spiral() {
+    TransitionField<Width, Height> field{};
+    TransitionField<Width, Height> radial = transition_radial<Width, Height>();
+    for (int y = 0; y < Height; y++) {
+        for (int x = 0; x < Width; x++) {
+            int i = y * Width + x;
+            int angle = transition_angle(2 * x - (Width - 1), 2 * y - (Height - 1));
+            // Turns laps of radius plus the angle within one lap, scaled to 0..255
+            int order = radial.value[i] * Turns * 256 / (radial.max + 1) + angle;
+            field.value[i] = (uint8_t)(order * 255 / ((Turns + 1) * 256 - 1));
+        }
+    }
+    field.max = 255;
+    return field;
+}
+
+// Draw colour on every pixel whose field value is in [level - width, level),
+// the band the transition front has just swept over. A width above the
+// field's max fills everything reached so far.
+template <class Target, int Width, int Height>
+void draw_transition(Target &target, const TransitionField<Width, Height> &field, int level,
+                     int width, ws2812_pixel_t colour) {
+    static_assert(Target::width == Width && Target::height == Height, "Field must match the surface");
+    if (!target.ready()) return;
+
+    const uint8_t *value = field.value;
+    for (int y = 0; y < Height; y++) {
+        for (int x = 0; x < Width; x++) {
+            if ((unsigned)(level - 1 - *value++) < (unsigned)width) {
+                target.put(x, y, colour);
+            }
+        }
+    }
+}
+
+// Level at which frame of frames has swept the whole field, band included
+template <int Width, int Height>
+int transition_level(const TransitionField<Width, Height> &field, int width, int frame, int frames) {
+    int end = field.max + 1 + (width <= field.max ? width : 0);
+    return frames > 0 ? end * frame / frames : end;
+}
+
+#endif // TRANSITIONS_H
@@ -1,30 +1,224 @@
 #include "WS2812.h"
+#include "WS2812_symbols.h"
 #include <stdlib.h>
 #include <string.h>
+#include <math.h>
+#include <stdio.h>
+#ifndef WS2812_HOST
 #include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "esp_attr.h"
 #include "freertos/FreeRTOS.h"
-#include "freertos/task.h"
+#endif
 
 #define TAG "WS2812"
 
-// WS2812 timing specifications (in nanoseconds)
-#define WS2812_T0H_NS 400
-#define WS2812_T0L_NS 850
-#define WS2812_T1H_NS 800
-#define WS2812_T1L_NS 450
+// WS2812 reset (latch) time
 #define WS2812_RESET_US 50
 
-ws2812_t* ws2812_init(uint16_t pixel_count, gpio_num_t gpio, rmt_channel_t channel) {
-    ws2812_t *strip = (ws2812_t*)malloc(sizeof(ws2812_t));
+// Supply current model: each colour channel draws up to 20 mA at full
+// output, plus about 1 mA of quiescent current per LED
+#define WS2812_MA_PER_CHANNEL 20
+#define WS2812_IDLE_MA_PER_LED 1
+
+// Scale 0-255 by 0-255 with rounding
+static inline uint8_t ws2812_scale8(uint8_t value, uint8_t scale) {
+    return (uint8_t)((value * scale + 127) / 255);
+}
+
+#define WS2812_RMT_SYM(b, n) (((b) & (0x80 >> (n))) ? WS2812_RMT_BIT1 : WS2812_RMT_BIT0)
+#define WS2812_RMT_BYTE(b) { \
+    WS2812_RMT_SYM(b, 0), WS2812_RMT_SYM(b, 1), WS2812_RMT_SYM(b, 2), WS2812_RMT_SYM(b, 3), \
+    WS2812_RMT_SYM(b, 4), WS2812_RMT_SYM(b, 5), WS2812_RMT_SYM(b, 6), WS2812_RMT_SYM(b, 7) }
+#define WS2812_RMT_BYTES4(b) \
+    WS2812_RMT_BYTE(b), WS2812_RMT_BYTE((b) + 1), WS2812_RMT_BYTE((b) + 2), WS2812_RMT_BYTE((b) + 3)
+#define WS2812_RMT_BYTES16(b) \
+    WS2812_RMT_BYTES4(b), WS2812_RMT_BYTES4((b) + 4), WS2812_RMT_BYTES4((b) + 8), WS2812_RMT_BYTES4((b) + 12)
+#define WS2812_RMT_BYTES64(b) \
+    WS2812_RMT_BYTES16(b), WS2812_RMT_BYTES16((b) + 16), WS2812_RMT_BYTES16((b) + 32), WS2812_RMT_BYTES16((b) + 48)
+
+// Built at compile time and kept in DRAM (8 KB) so the RMT translator never
+// waits on flash cache
+const DRAM_ATTR uint32_t ws2812_symbol_lut[256][8] = {
+    WS2812_RMT_BYTES64(0), WS2812_RMT_BYTES64(64), WS2812_RMT_BYTES64(128), WS2812_RMT_BYTES64(192)
+};
+
+static void ws2812_timing_add(ws2812_timing_t *timing, uint32_t us) {
+    if (!timing->count || us < timing->min_us) {
+        timing->min_us = us;
+    }
+    if (us > timing->max_us) {
+        timing->max_us = us;
+    }
+    timing->count++;
+    timing->total_us += us;
+
+    int bucket = 0;
+    for (uint32_t limit = 128; us >= limit && bucket < WS2812_HIST_BUCKETS - 1; limit <<= 1) {
+        bucket++;
+    }
+    timing->hist[bucket]++;
+}
+
+static void ws2812_timing_log(const char *name, const ws2812_timing_t *timing) {
+    if (!timing->count) {
+        ESP_LOGI(TAG, "%-8s no samples", name);
+        return;
+    }
+    ESP_LOGI(TAG, "%-8s n=%u min=%u avg=%u max=%u us", name, (unsigned)timing->count,
+             (unsigned)timing->min_us, (unsigned)(timing->total_us / timing->count),
+             (unsigned)timing->max_us);
+
+    char line[WS2812_HIST_BUCKETS * 11 + 1];
+    int len = 0;
+    for (int i = 0; i < WS2812_HIST_BUCKETS; i++) {
+        len += snprintf(line + len, sizeof(line) - len, " %u", (unsigned)timing->hist[i]);
+    }
+    ESP_LOGI(TAG, "%-8s hist <128us..>=128ms:%s", name, line);
+}
+
+// Resolve one palette entry through the correction and post-process tables
+static void ws2812_resolve_entry(ws2812_t *strip, int entry) {
+    ws2812_pixel_t c = strip->palette->entries[entry];
+    uint8_t *wire = strip->palette->wire[entry];
+    wire[0] = strip->out_g[c.g];
+    wire[1] = strip->out_r[c.r];
+    wire[2] = strip->out_b[c.b];
+    strip->palette->load[entry] = strip->lut_r[c.r] + strip->lut_g[c.g] + strip->lut_b[c.b];
+}
+
+// Recount the corrected channel sum from scratch; only needed when the
+// tables, the palette or the buffer format change, pixel writes keep it up
+// to date
+static void ws2812_recompute_load(ws2812_t *strip) {
+    uint32_t load = 0;
+    if (strip->format == WS2812_FORMAT_PALETTE) {
+        if (strip->palette_dirty) {
+            for (int i = 0; i < strip->palette_used; i++) {
+                ws2812_resolve_entry(strip, i);
+            }
+            strip->palette_dirty = false;
+        }
+        for (int i = 0; i < strip->pixel_count; i++) {
+            load += strip->palette->load[strip->indices[i]];
+        }
+    } else if (strip->format == WS2812_FORMAT_NATIVE) {
+        for (int i = 0; i < strip->pixel_count * 3; i++) {
+            load += strip->native[i];
+        }
+    } else {
+        for (int i = 0; i < strip->pixel_count; i++) {
+            ws2812_pixel_t pixel = strip->pixels[i];
+            load += strip->lut_r[pixel.r] + strip->lut_g[pixel.g] + strip->lut_b[pixel.b];
+        }
+    }
+    strip->load = load;
+}
+
+// Rebuild the post-process tables, which work on corrected bytes so they
+// apply to both buffer formats, and fold them behind the correction tables
+// for RGB encoding. Identity tables when every stage is at its default.
+static void ws2812_rebuild_post(ws2812_t *strip) {
+    // Every pixel may encode differently now
+    strip->dirty_end = strip->pixel_count;
+    strip->post_active = strip->fade != 255 || strip->flash || strip->invert ||
+                         strip->tint[0] != 255 || strip->tint[1] != 255 || strip->tint[2] != 255;
+
+    const uint8_t *lut[3] = {strip->lut_r, strip->lut_g, strip->lut_b};
+    uint8_t *post[3] = {strip->post_r, strip->post_g, strip->post_b};
+    uint8_t *out[3] = {strip->out_r, strip->out_g, strip->out_b};
+
+    for (int ch = 0; ch < 3; ch++) {
+        // Invert and flash towards this channel's full corrected output, so
+        // they respect brightness and white balance
+        uint8_t full = lut[ch][255];
+        uint8_t scale = ws2812_scale8(strip->tint[ch], strip->fade);
+        for (int v = 0; v < 256; v++) {
+            uint8_t c = v;
+            if (strip->invert) {
+                c = v < full ? full - v : 0;
+            }
+            if (c < full) {
+                c += ws2812_scale8(full - c, strip->flash);
+            }
+            post[ch][v] = ws2812_scale8(c, scale);
+        }
+        for (int v = 0; v < 256; v++) {
+            out[ch][v] = post[ch][lut[ch][v]];
+        }
+    }
+
+    // Palette entries resolve through the tables too
+    strip->palette_dirty = true;
+}
+
+// Rebuild the per-channel correction tables. Runs only when brightness, gamma
+// or white balance change, so encoding a frame is pure table lookups.
+static void ws2812_rebuild_lut(ws2812_t *strip) {
+    // Every pixel may encode differently now
+    strip->dirty_end = strip->pixel_count;
+
+    uint8_t scale_r = ws2812_scale8(strip->brightness, strip->white_balance[0]);
+    uint8_t scale_g = ws2812_scale8(strip->brightness, strip->white_balance[1]);
+    uint8_t scale_b = ws2812_scale8(strip->brightness, strip->white_balance[2]);
+
+    for (int v = 0; v < 256; v++) {
+        uint8_t c = strip->gamma_lut[v];
+        strip->lut_r[v] = ws2812_scale8(c, scale_r);
+        strip->lut_g[v] = ws2812_scale8(c, scale_g);
+        strip->lut_b[v] = ws2812_scale8(c, scale_b);
+
+        // Never round a lit channel down to black at low brightness
+        if (v > 0) {
+            if (!strip->lut_r[v] && scale_r) strip->lut_r[v] = 1;
+            if (!strip->lut_g[v] && scale_g) strip->lut_g[v] = 1;
+            if (!strip->lut_b[v] && scale_b) strip->lut_b[v] = 1;
+        }
+    }
+
+    ws2812_rebuild_post(strip);
+
+    if (strip->pixels) {
+        ws2812_recompute_load(strip);
+    }
+}
+
+static void ws2812_rebuild_gamma(ws2812_t *strip) {
+    for (int v = 0; v < 256; v++) {
+        strip->gamma_lut[v] = (uint8_t)(powf(v / 255.0f, strip->gamma) * 255.0f + 0.5f);
+    }
+}
+
+ws2812_t* ws2812_alloc(uint16_t pixel_count, uint8_t segment_count) {
+    if (segment_count == 0 || segment_count > WS2812_MAX_SEGMENTS) {
+        ESP_LOGE(TAG, "Unsupported segment count %d", segment_count);
+        return NULL;
+    }
+
+    ws2812_t *strip = (ws2812_t*)calloc(1, sizeof(ws2812_t));
     if (!strip) {
         ESP_LOGE(TAG, "Failed to allocate memory for WS2812 strip");
         return NULL;
     }
 
-    strip->channel = channel;
-    strip->gpio = gpio;
+    strip->segment_count = segment_count;
     strip->pixel_count = pixel_count;
     strip->brightness = 255;
+    strip->gamma = 1.0f;
+    memset(strip->white_balance, 255, sizeof(strip->white_balance));
+    strip->fade = 255;
+    memset(strip->tint, 255, sizeof(strip->tint));
+    ws2812_rebuild_gamma(strip);
+    ws2812_rebuild_lut(strip);
+
+    // Split the pixels into equal runs; the last one takes any remainder
+    uint16_t run = pixel_count / segment_count;
+    for (int s = 0; s < segment_count; s++) {
+        ws2812_segment_t *seg = &strip->segments[s];
+        seg->start = s * run;
+        seg->count = (s == segment_count - 1) ? pixel_count - seg->start : run;
+    }
 
     // Allocate pixel buffer
     strip->pixels = (ws2812_pixel_t*)calloc(pixel_count, sizeof(ws2812_pixel_t));
@@ -33,25 +227,56 @@ ws2812_t* ws2812_init(uint16_t pixel_count, gpio_num_t gpio, rmt_channel_t chann
         free(strip);
         return NULL;
     }
+    strip->native = (uint8_t*)strip->pixels;
+    strip->indices = (uint8_t*)strip->pixels;
+    strip->format = WS2812_FORMAT_RGB;
+    strip->limit_scale = 256;
+
+    // Allocate the wire buffer once: 3 bytes per pixel. Transports encode
+    // symbols from it on the fly.
+    strip->wire_len = pixel_count * 3;
+    strip->wire = (uint8_t*)calloc(strip->wire_len, 1);
+    if (!strip->wire) {
+        ESP_LOGE(TAG, "Failed to allocate wire buffer");
+        free(strip->pixels);
+        free(strip);
+        return NULL;
+    }
 
-    // Configure RMT
-    rmt_config_t config = RMT_DEFAULT_CONFIG_TX(gpio, channel);
-    config.clk_div = 2;  // 40MHz clock
-    config.mem_block_num = 1;
+    strip->force_refresh = true;  // Wire buffer holds no frame yet
 
-    ESP_ERROR_CHECK(rmt_config(&config));
-    ESP_ERROR_CHECK(rmt_driver_install(channel, 0, 0));
+    strip->stats.free_heap = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    strip->stats.min_largest_block = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
 
-    ESP_LOGI(TAG, "WS2812 initialized: %d pixels on GPIO %d", pixel_count, gpio);
     return strip;
 }
 
+void IRAM_ATTR ws2812_transport_done(ws2812_t *strip) {
+    if (!strip || !strip->tx_active) return;
+
+    // The reset latch runs from here; ws2812_show_async() holds off the
+    // next frame until it has elapsed
+    strip->tx_end_us = esp_timer_get_time();
+
+    // Notify once the last segment of the frame is done
+    if (--strip->tx_active == 0 && strip->done_cb) {
+        strip->done_cb(strip, strip->done_arg);
+    }
+}
+
 void ws2812_free(ws2812_t *strip) {
     if (strip) {
-        rmt_driver_uninstall(strip->channel);
+        ws2812_wait(strip, portMAX_DELAY);
+        if (strip->transport && strip->transport->deinit) {
+            strip->transport->deinit(strip);
+        }
         if (strip->pixels) {
             free(strip->pixels);
         }
+        if (strip->wire) {
+            free(strip->wire);
+        }
+        free(strip->palette);
         free(strip);
     }
 }
@@ -59,91 +284,602 @@ void ws2812_free(ws2812_t *strip) {
 void ws2812_set_brightness(ws2812_t *strip, uint8_t brightness) {
     if (strip) {
         strip->brightness = brightness;
+        ws2812_rebuild_lut(strip);
+    }
+}
+
+void ws2812_set_gamma(ws2812_t *strip, float gamma) {
+    if (strip && gamma > 0) {
+        strip->gamma = gamma;
+        ws2812_rebuild_gamma(strip);
+        ws2812_rebuild_lut(strip);
+    }
+}
+
+void ws2812_set_white_balance(ws2812_t *strip, uint8_t r, uint8_t g, uint8_t b) {
+    if (strip) {
+        strip->white_balance[0] = r;
+        strip->white_balance[1] = g;
+        strip->white_balance[2] = b;
+        ws2812_rebuild_lut(strip);
+    }
+}
+
+// Point the format views at a (re)allocated pixel buffer
+static void ws2812_set_buffer(ws2812_t *strip, void *buffer) {
+    strip->pixels = (ws2812_pixel_t*)buffer;
+    strip->native = (uint8_t*)buffer;
+    strip->indices = (uint8_t*)buffer;
+}
+
+void ws2812_set_format(ws2812_t *strip, ws2812_format_t format) {
+    if (!strip || format == strip->format) return;
+
+    // Palette state only exists in palette format, so RGB and native strips
+    // do not carry it
+    ws2812_palette_t *palette = NULL;
+    if (format == WS2812_FORMAT_PALETTE) {
+        palette = (ws2812_palette_t*)calloc(1, sizeof(ws2812_palette_t));
+        if (!palette) {
+            ESP_LOGE(TAG, "Failed to allocate palette");
+            return;
+        }
+    }
+
+    // Palette indices expand back to RGB first. Going backwards, each index
+    // is read before the 3 bytes written for it can reach it.
+    if (strip->format == WS2812_FORMAT_PALETTE) {
+        void *buffer = realloc(strip->pixels, strip->pixel_count * sizeof(ws2812_pixel_t));
+        if (!buffer) {
+            ESP_LOGE(TAG, "Failed to grow pixel buffer");
+            return;
+        }
+        ws2812_set_buffer(strip, buffer);
+        for (int i = strip->pixel_count - 1; i >= 0; i--) {
+            strip->pixels[i] = strip->palette->entries[strip->indices[i]];
+        }
+        free(strip->palette);
+        strip->palette = NULL;
+        strip->format = WS2812_FORMAT_RGB;
+    }
+
+    // RGB and native are both 3 bytes per pixel in the same buffer; convert
+    // in place
+    ws2812_format_t target = format == WS2812_FORMAT_NATIVE ? format : WS2812_FORMAT_RGB;
+    if (strip->format != target) {
+        for (int i = 0; i < strip->pixel_count; i++) {
+            uint8_t *bytes = strip->native + i * 3;
+            if (target == WS2812_FORMAT_NATIVE) {
+                ws2812_pixel_t pixel = strip->pixels[i];
+                bytes[0] = strip->lut_g[pixel.g];
+                bytes[1] = strip->lut_r[pixel.r];
+                bytes[2] = strip->lut_b[pixel.b];
+            } else {
+                ws2812_pixel_t pixel = {bytes[1], bytes[0], bytes[2]};
+                strip->pixels[i] = pixel;
+            }
+        }
+        strip->format = target;
+    }
+
+    // RGB packs down to one index per pixel. Going forwards, each pixel is
+    // read before any index written can reach it.
+    if (format == WS2812_FORMAT_PALETTE) {
+        strip->palette = palette;
+        strip->palette_fixed = 1;     // Entry 0, black, is the clear colour
+        strip->palette_used = 1;
+        strip->palette_hit = 0;
+        strip->palette_dirty = true;
+        for (int i = 0; i < strip->pixel_count; i++) {
+            ws2812_pixel_t pixel = strip->pixels[i];
+            strip->indices[i] = ws2812_palette_match(strip, pixel.r, pixel.g, pixel.b);
+        }
+        // Shrinking in place cannot fail in practice; keep the old block if it does
+        void *buffer = realloc(strip->pixels, strip->pixel_count);
+        if (buffer) {
+            ws2812_set_buffer(strip, buffer);
+        }
+        strip->format = format;
+    }
+
+    strip->dirty_end = strip->pixel_count;
+    ws2812_recompute_load(strip);
+}
+
+void ws2812_set_palette(ws2812_t *strip, uint8_t entry, uint8_t r, uint8_t g, uint8_t b) {
+    if (!strip || !strip->palette) return;
+
+    ws2812_pixel_t c = {r, g, b};
+    strip->palette->entries[entry] = c;
+    if (entry >= strip->palette_fixed) {
+        strip->palette_fixed = entry + 1;
+    }
+    if (strip->palette_used < strip->palette_fixed) {
+        strip->palette_used = strip->palette_fixed;
+    }
+
+    // Pixels showing the entry are not written, so re-encode them all
+    strip->palette_dirty = true;
+    strip->dirty_end = strip->pixel_count;
+}
+
+uint8_t ws2812_palette_match(ws2812_t *strip, uint8_t r, uint8_t g, uint8_t b) {
+    if (!strip || !strip->palette) return 0;
+
+    const ws2812_pixel_t *c = &strip->palette->entries[strip->palette_hit];
+    if (c->r == r && c->g == g && c->b == b) {
+        return strip->palette_hit;
+    }
+
+    int nearest = 0;
+    int nearest_distance = 3 * 256;
+    for (int i = 0; i < strip->palette_used; i++) {
+        c = &strip->palette->entries[i];
+        int distance = abs(c->r - r) + abs(c->g - g) + abs(c->b - b);
+        if (distance == 0) {
+            strip->palette_hit = i;
+            return i;
+        }
+        if (distance < nearest_distance) {
+            nearest = i;
+            nearest_distance = distance;
+        }
+    }
+
+    // Append the colour while there is room, resolving just the new entry
+    if (strip->palette_used < WS2812_PALETTE_SIZE) {
+        int entry = strip->palette_used++;
+        ws2812_pixel_t colour = {r, g, b};
+        strip->palette->entries[entry] = colour;
+        if (!strip->palette_dirty) {
+            ws2812_resolve_entry(strip, entry);
+        }
+        strip->palette_hit = entry;
+        return entry;
+    }
+    return nearest;
+}
+
+void ws2812_set_pixel_index(ws2812_t *strip, uint16_t index, uint8_t entry) {
+    if (strip && index < strip->pixel_count && strip->format == WS2812_FORMAT_PALETTE) {
+        ws2812_put_index(strip, index, entry);
+    }
+}
+
+void ws2812_set_current_limit(ws2812_t *strip, uint32_t milliamps) {
+    if (strip) {
+        strip->current_limit_ma = milliamps;
+    }
+}
+
+void ws2812_set_fade(ws2812_t *strip, uint8_t level) {
+    if (strip) {
+        strip->fade = level;
+        ws2812_rebuild_post(strip);
+    }
+}
+
+void ws2812_set_flash(ws2812_t *strip, uint8_t level) {
+    if (strip) {
+        strip->flash = level;
+        ws2812_rebuild_post(strip);
+    }
+}
+
+void ws2812_set_invert(ws2812_t *strip, bool invert) {
+    if (strip) {
+        strip->invert = invert;
+        ws2812_rebuild_post(strip);
+    }
+}
+
+void ws2812_set_tint(ws2812_t *strip, uint8_t r, uint8_t g, uint8_t b) {
+    if (strip) {
+        strip->tint[0] = r;
+        strip->tint[1] = g;
+        strip->tint[2] = b;
+        ws2812_rebuild_post(strip);
+    }
+}
+
+// Palette or table changes leave the palette to resolve before use
+static void ws2812_resolve_palette(ws2812_t *strip) {
+    if (strip->format == WS2812_FORMAT_PALETTE && strip->palette_dirty) {
+        ws2812_recompute_load(strip);
+    }
+}
+
+// Channel sum of the frame as it will be sent. The incremental sum stops
+// before post-processing, so while a stage is active count through it.
+static uint32_t ws2812_output_load(ws2812_t *strip) {
+    ws2812_resolve_palette(strip);
+    if (!strip->post_active) return strip->load;
+
+    uint32_t load = 0;
+    if (strip->format == WS2812_FORMAT_PALETTE) {
+        for (int i = 0; i < strip->pixel_count; i++) {
+            const uint8_t *wire = strip->palette->wire[strip->indices[i]];
+            load += wire[0] + wire[1] + wire[2];
+        }
+    } else if (strip->format == WS2812_FORMAT_NATIVE) {
+        const uint8_t *bytes = strip->native;
+        for (int i = 0; i < strip->pixel_count; i++, bytes += 3) {
+            load += strip->post_g[bytes[0]] + strip->post_r[bytes[1]] + strip->post_b[bytes[2]];
+        }
+    } else {
+        for (int i = 0; i < strip->pixel_count; i++) {
+            ws2812_pixel_t pixel = strip->pixels[i];
+            load += strip->out_r[pixel.r] + strip->out_g[pixel.g] + strip->out_b[pixel.b];
+        }
     }
+    return load;
+}
+
+uint32_t ws2812_estimate_current(ws2812_t *strip) {
+    if (!strip || !strip->pixels) return 0;
+    return strip->pixel_count * WS2812_IDLE_MA_PER_LED +
+           ws2812_output_load(strip) * WS2812_MA_PER_CHANNEL / 255;
 }
 
 void ws2812_set_pixel(ws2812_t *strip, uint16_t index, uint8_t r, uint8_t g, uint8_t b) {
     if (strip && index < strip->pixel_count) {
-        strip->pixels[index].r = r;
-        strip->pixels[index].g = g;
-        strip->pixels[index].b = b;
+        ws2812_put(strip, index, r, g, b);
     }
 }
 
 void ws2812_set_pixel_rgb(ws2812_t *strip, uint16_t index, ws2812_pixel_t color) {
     if (strip && index < strip->pixel_count) {
-        strip->pixels[index] = color;
+        ws2812_put(strip, index, color.r, color.g, color.b);
     }
 }
 
 ws2812_pixel_t ws2812_get_pixel(ws2812_t *strip, uint16_t index) {
     ws2812_pixel_t pixel = {0, 0, 0};
     if (strip && index < strip->pixel_count) {
-        pixel = strip->pixels[index];
+        if (strip->format == WS2812_FORMAT_PALETTE) {
+            pixel = strip->palette->entries[strip->indices[index]];
+        } else if (strip->format == WS2812_FORMAT_NATIVE) {
+            const uint8_t *bytes = strip->native + index * 3;
+            pixel.r = bytes[1];
+            pixel.g = bytes[0];
+            pixel.b = bytes[2];
+        } else {
+            pixel = strip->pixels[index];
+        }
     }
     return pixel;
 }
 
 void ws2812_clear(ws2812_t *strip) {
     if (strip && strip->pixels) {
-        memset(strip->pixels, 0, strip->pixel_count * sizeof(ws2812_pixel_t));
+        if (strip->format == WS2812_FORMAT_PALETTE) {
+            // Drop the appended entries along with the pixels using them
+            memset(strip->indices, 0, strip->pixel_count);
+            strip->palette_used = strip->palette_fixed;
+            strip->palette_hit = 0;
+            strip->load = strip->pixel_count * strip->palette->load[0];
+            strip->dirty_end = strip->pixel_count;
+            return;
+        }
+        if (strip->format == WS2812_FORMAT_NATIVE) {
+            // Black through the tables, in wire order
+            uint8_t *bytes = strip->native;
+            for (int i = 0; i < strip->pixel_count; i++) {
+                *bytes++ = strip->lut_g[0];
+                *bytes++ = strip->lut_r[0];
+                *bytes++ = strip->lut_b[0];
+            }
+        } else {
+            memset(strip->pixels, 0, strip->pixel_count * sizeof(ws2812_pixel_t));
+        }
+        strip->load = strip->pixel_count * (strip->lut_r[0] + strip->lut_g[0] + strip->lut_b[0]);
+        strip->dirty_end = strip->pixel_count;
     }
 }
 
-static void ws2812_write_byte(rmt_item32_t *item, uint8_t byte) {
-    for (int bit = 7; bit >= 0; bit--) {
-        if (byte & (1 << bit)) {
-            // Send 1
-            item->level0 = 1;
-            item->duration0 = WS2812_T1H_NS / 25;  // Convert ns to ticks (40MHz/2 = 20MHz = 50ns per tick)
-            item->level1 = 0;
-            item->duration1 = WS2812_T1L_NS / 25;
-        } else {
-            // Send 0
-            item->level0 = 1;
-            item->duration0 = WS2812_T0H_NS / 25;
-            item->level1 = 0;
-            item->duration1 = WS2812_T0L_NS / 25;
+// Encode pixels [seg->start, end) of an RGB buffer into the wire buffer
+// through the correction and post-process tables, scaled by scale/256 when
+// the current limiter kicks in; returns the changed prefix length
+static uint16_t ws2812_encode_rgb(ws2812_t *strip, const ws2812_segment_t *seg, uint16_t end,
+                                  uint16_t scale) {
+    const ws2812_pixel_t *pixel = strip->pixels + seg->start;
+    uint8_t *out = strip->wire + seg->start * 3;
+    uint16_t send_pixels = 0;
+    for (int i = seg->start; i < end; i++, pixel++) {
+        // WS2812 expects GRB order
+        uint8_t g = strip->out_g[pixel->g];
+        uint8_t r = strip->out_r[pixel->r];
+        uint8_t b = strip->out_b[pixel->b];
+        if (scale < 256) {
+            g = (g * scale) >> 8;
+            r = (r * scale) >> 8;
+            b = (b * scale) >> 8;
+        }
+        if ((out[0] ^ g) | (out[1] ^ r) | (out[2] ^ b)) {
+            send_pixels = i - seg->start + 1;
+        }
+        *out++ = g;
+        *out++ = r;
+        *out++ = b;
+    }
+    return send_pixels;
+}
+
+// Native buffers already hold wire bytes: find the last changed byte and
+// copy the prefix up to it. Post-processed or limited frames go through
+// the post tables and scale byte by byte.
+static uint16_t ws2812_encode_native(ws2812_t *strip, const ws2812_segment_t *seg, uint16_t end,
+                                     uint16_t scale) {
+    if (end <= seg->start) return 0;
+
+    const uint8_t *src = strip->native + seg->start * 3;
+    uint8_t *out = strip->wire + seg->start * 3;
+    size_t len = (end - seg->start) * 3;
+
+    if (scale < 256 || strip->post_active) {
+        // Wire order
+        const uint8_t *post[3] = {strip->post_g, strip->post_r, strip->post_b};
+        size_t changed = 0;
+        for (size_t i = 0; i < len; i += 3) {
+            for (int c = 0; c < 3; c++) {
+                uint8_t v = (post[c][src[i + c]] * scale) >> 8;
+                if (out[i + c] != v) {
+                    changed = i + c + 1;
+                }
+                out[i + c] = v;
+            }
+        }
+        return (changed + 2) / 3;
+    }
+
+    while (len && src[len - 1] == out[len - 1]) {
+        len--;
+    }
+    memcpy(out, src, len);
+    return (len + 2) / 3;
+}
+
+// Palette buffers: look each index up in the resolved palette
+static uint16_t ws2812_encode_palette(ws2812_t *strip, const ws2812_segment_t *seg, uint16_t end,
+                                      uint16_t scale) {
+    const uint8_t *index = strip->indices + seg->start;
+    uint8_t *out = strip->wire + seg->start * 3;
+    uint16_t send_pixels = 0;
+    for (int i = seg->start; i < end; i++) {
+        const uint8_t *wire = strip->palette->wire[*index++];
+        uint8_t g = wire[0];
+        uint8_t r = wire[1];
+        uint8_t b = wire[2];
+        if (scale < 256) {
+            g = (g * scale) >> 8;
+            r = (r * scale) >> 8;
+            b = (b * scale) >> 8;
         }
-        item++;
+        if ((out[0] ^ g) | (out[1] ^ r) | (out[2] ^ b)) {
+            send_pixels = i - seg->start + 1;
+        }
+        *out++ = g;
+        *out++ = r;
+        *out++ = b;
+    }
+    return send_pixels;
+}
+
+uint16_t ws2812_encode_segment(ws2812_t *strip, const ws2812_segment_t *seg, uint16_t end,
+                               uint16_t scale) {
+    if (strip->format == WS2812_FORMAT_PALETTE) {
+        return ws2812_encode_palette(strip, seg, end, scale);
+    }
+    if (strip->format == WS2812_FORMAT_NATIVE) {
+        return ws2812_encode_native(strip, seg, end, scale);
     }
+    return ws2812_encode_rgb(strip, seg, end, scale);
 }
 
 void ws2812_show(ws2812_t *strip) {
-    if (!strip || !strip->pixels) return;
+    ws2812_show_async(strip);
+    ws2812_wait(strip, portMAX_DELAY);
+}
 
-    size_t num_items = strip->pixel_count * 3 * 8;  // 3 bytes per pixel, 8 bits per byte
-    rmt_item32_t *items = (rmt_item32_t*)malloc(num_items * sizeof(rmt_item32_t));
-    if (!items) {
-        ESP_LOGE(TAG, "Failed to allocate RMT items");
-        return;
+void ws2812_show_async(ws2812_t *strip) {
+    if (!strip || !strip->pixels || !strip->wire || !strip->transport) return;
+
+    // The wire buffer is still being clocked out by the previous frame
+    ws2812_wait(strip, portMAX_DELAY);
+
+    int64_t start_us = esp_timer_get_time();
+    if (strip->last_show_us) {
+        ws2812_timing_add(&strip->stats.interval, (uint32_t)(start_us - strip->last_show_us));
+    }
+    strip->last_show_us = start_us;
+
+    // Scale the whole frame down if its estimated draw is over budget. A
+    // different scale from last frame re-encodes every pixel. Without a
+    // limit the estimate is only made when stats are read.
+    uint16_t scale = 256;
+    ws2812_resolve_palette(strip);
+    if (strip->current_limit_ma) {
+        strip->stats.current_ma = ws2812_estimate_current(strip);
+    }
+    if (strip->current_limit_ma && strip->stats.current_ma > strip->current_limit_ma) {
+        // A budget below the LEDs' idle draw leaves nothing for the colours,
+        // even when the frame is (nearly) black
+        uint32_t idle_ma = strip->pixel_count * WS2812_IDLE_MA_PER_LED;
+        uint32_t budget_ma = strip->current_limit_ma > idle_ma ? strip->current_limit_ma - idle_ma : 0;
+        uint32_t colour_ma = strip->stats.current_ma - idle_ma;
+        scale = strip->stats.current_ma > idle_ma ? budget_ma * 256 / colour_ma : 0;
+        strip->stats.limited_frames++;
+    }
+    if (scale != strip->limit_scale) {
+        strip->dirty_end = strip->pixel_count;
+        strip->limit_scale = scale;
     }
 
-    rmt_item32_t *item = items;
+    // Convert pixels to wire bytes, comparing against the previous frame
+    // still held in the wire buffer. Pixels past dirty_end were not written,
+    // so their bytes are current.
+    uint16_t send_pixels = 0;
+    for (int s = 0; s < strip->segment_count; s++) {
+        ws2812_segment_t *seg = &strip->segments[s];
+        uint16_t end = seg->start + seg->count;
+        if (end > strip->dirty_end) {
+            end = strip->dirty_end;
+        }
 
-    // Convert pixels to RMT items with brightness adjustment
-    for (int i = 0; i < strip->pixel_count; i++) {
-        uint8_t r = (strip->pixels[i].r * strip->brightness) / 255;
-        uint8_t g = (strip->pixels[i].g * strip->brightness) / 255;
-        uint8_t b = (strip->pixels[i].b * strip->brightness) / 255;
+        seg->send_pixels = ws2812_encode_segment(strip, seg, end, scale);
+        if (strip->force_refresh) {
+            seg->send_pixels = seg->count;
+        }
+        if (seg->send_pixels > send_pixels) {
+            send_pixels = seg->send_pixels;
+        }
+    }
+    strip->dirty_end = 0;
+    ws2812_timing_add(&strip->stats.encode, (uint32_t)(esp_timer_get_time() - start_us));
+
+    if (send_pixels) {
+        // Synchronized outputs only start once every one of them has data,
+        // so an unchanged run still resends its first pixel
+        if (strip->segment_count > 1) {
+            for (int s = 0; s < strip->segment_count; s++) {
+                if (!strip->segments[s].send_pixels) {
+                    strip->segments[s].send_pixels = 1;
+                }
+            }
+        }
 
-        // WS2812 expects GRB order
-        ws2812_write_byte(item, g);
-        item += 8;
-        ws2812_write_byte(item, r);
-        item += 8;
-        ws2812_write_byte(item, b);
-        item += 8;
+        // The line must stay low for the reset time after the previous frame.
+        // Encoding usually covers it; only spin for whatever is left.
+        int64_t latch_us = strip->tx_end_us + WS2812_RESET_US;
+        while (esp_timer_get_time() < latch_us) {
+        }
+
+        // Hand each run's prefix to the transport without waiting
+        bool ok = true;
+        strip->tx_active = strip->segment_count;
+        strip->tx_start_us = esp_timer_get_time();
+        for (int s = 0; s < strip->segment_count; s++) {
+            ws2812_segment_t *seg = &strip->segments[s];
+            if (strip->transport->start(strip, s, strip->wire + seg->start * 3,
+                                        seg->send_pixels * 3) != ESP_OK) {
+                ok = false;
+            }
+        }
+        strip->tx_pending = true;
+
+        if (ok) {
+            strip->force_refresh = false;
+            strip->stats.frames++;
+            strip->stats.last_sent_pixels = send_pixels;
+        } else {
+            // The wire buffer no longer matches what the LEDs latched
+            strip->force_refresh = true;
+        }
+    } else {
+        // Nothing to send, so the frame is already complete; callers waiting
+        // on the completion callback still get one per frame
+        strip->stats.skipped_frames++;
+        if (strip->done_cb) {
+            strip->done_cb(strip, strip->done_arg);
+        }
+    }
+
+    // Track show latency
+    uint32_t elapsed_us = (uint32_t)(esp_timer_get_time() - start_us);
+    strip->stats.last_show_us = elapsed_us;
+    if (elapsed_us > strip->stats.max_show_us) {
+        strip->stats.max_show_us = elapsed_us;
+    }
+}
+
+void ws2812_force_refresh(ws2812_t *strip) {
+    if (strip) {
+        strip->force_refresh = true;
+    }
+}
+
+bool ws2812_wait(ws2812_t *strip, TickType_t timeout) {
+    if (!strip || !strip->tx_pending) return true;
+
+    for (int s = 0; s < strip->segment_count; s++) {
+        if (strip->transport->wait(strip, s, timeout) != ESP_OK) {
+            return false;
+        }
+    }
+    strip->tx_pending = false;
+
+    if (strip->tx_end_us >= strip->tx_start_us) {
+        ws2812_timing_add(&strip->stats.transmit, (uint32_t)(strip->tx_end_us - strip->tx_start_us));
+    }
+    return true;
+}
+
+bool ws2812_is_busy(ws2812_t *strip) {
+    if (!strip || !strip->tx_pending) return false;
+
+    for (int s = 0; s < strip->segment_count; s++) {
+        if (strip->transport->wait(strip, s, 0) != ESP_OK) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ws2812_set_done_callback(ws2812_t *strip, ws2812_done_cb_t cb, void *arg) {
+    if (strip) {
+        strip->done_cb = cb;
+        strip->done_arg = arg;
     }
+}
 
-    // Send the data
-    rmt_write_items(strip->channel, items, num_items, true);
-    rmt_wait_tx_done(strip->channel, portMAX_DELAY);
+// Sample heap health, and the current estimate when the limiter is off and
+// ws2812_show() skips it. Finding the largest free block walks the heap
+// under the allocator lock, so this runs when stats are read rather than per
+// frame; with no per-frame allocation the block should stay flat.
+static void ws2812_sample_stats(ws2812_t *strip) {
+    if (!strip->current_limit_ma) {
+        strip->stats.current_ma = ws2812_estimate_current(strip);
+    }
+    size_t largest_block = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+    strip->stats.free_heap = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    if (largest_block < strip->stats.min_largest_block) {
+        strip->stats.min_largest_block = largest_block;
+    }
+}
+
+void ws2812_get_stats(ws2812_t *strip, ws2812_stats_t *stats) {
+    if (strip && stats) {
+        ws2812_sample_stats(strip);
+        *stats = strip->stats;
+    }
+}
 
-    free(items);
+void ws2812_reset_stats(ws2812_t *strip) {
+    if (strip) {
+        memset(&strip->stats.encode, 0, sizeof(strip->stats.encode));
+        memset(&strip->stats.transmit, 0, sizeof(strip->stats.transmit));
+        memset(&strip->stats.interval, 0, sizeof(strip->stats.interval));
+        strip->stats.max_show_us = 0;
+    }
+}
 
-    // Reset signal
-    vTaskDelay(pdMS_TO_TICKS(1));
+void ws2812_log_stats(ws2812_t *strip) {
+    if (!strip) return;
+
+    ws2812_sample_stats(strip);
+    const ws2812_stats_t *stats = &strip->stats;
+    ESP_LOGI(TAG, "%s: %u frames sent, %u skipped, last prefix %u px, show last/max %u/%u us",
+             strip->transport ? strip->transport->name : "?", (unsigned)stats->frames,
+             (unsigned)stats->skipped_frames, stats->last_sent_pixels,
+             (unsigned)stats->last_show_us, (unsigned)stats->max_show_us);
+    ESP_LOGI(TAG, "current %u mA (limit %u mA), %u frames limited",
+             (unsigned)stats->current_ma, (unsigned)strip->current_limit_ma,
+             (unsigned)stats->limited_frames);
+    ws2812_timing_log("encode", &stats->encode);
+    ws2812_timing_log("transmit", &stats->transmit);
+    ws2812_timing_log("interval", &stats->interval);
+    ESP_LOGI(TAG, "heap free %u, min largest block %u",
+             (unsigned)stats->free_heap, (unsigned)stats->min_largest_block);
 }
 
 ws2812_pixel_t ws2812_hsv_to_rgb(uint8_t h, uint8_t s, uint8_t v) {
@@ -206,4 +942,58 @@ ws2812_pixel_t ws2812_wheel(uint8_t pos) {
     }
 
     return color;
-}
\ No newline at end of file
+}
+
+// Full saturation/value HSV and colour wheel outputs for every position,
+// built on first use of the span fills
+static ws2812_pixel_t s_hue_lut[256];
+static ws2812_pixel_t s_wheel_lut[256];
+static bool s_hue_lut_ready = false;
+
+static void ws2812_build_hue_luts(void) {
+    for (int i = 0; i < 256; i++) {
+        s_hue_lut[i] = ws2812_hsv_to_rgb(i, 255, 255);
+        s_wheel_lut[i] = ws2812_wheel(i);
+    }
+    s_hue_lut_ready = true;
+}
+
+// Clip a span to the strip once; returns the usable pixel count
+static uint16_t ws2812_clip_span(ws2812_t *strip, uint16_t start, uint16_t count) {
+    if (!strip || start >= strip->pixel_count) return 0;
+    if (count > strip->pixel_count - start) {
+        count = strip->pixel_count - start;
+    }
+    if (!s_hue_lut_ready) {
+        ws2812_build_hue_luts();
+    }
+    return count;
+}
+
+void ws2812_fill_hsv_gradient(ws2812_t *strip, uint16_t start, uint16_t count,
+                              uint8_t hue, uint16_t hue_step, uint8_t s, uint8_t v) {
+    count = ws2812_clip_span(strip, start, count);
+
+    uint16_t h = hue << 8;  // 8.8 fixed-point hue
+    for (uint16_t i = 0; i < count; i++, h += hue_step) {
+        ws2812_pixel_t c = s_hue_lut[h >> 8];
+        if (s != 255 || v != 255) {
+            // Desaturate towards white, then scale by value
+            c.r = ((255 - ((s * (255 - c.r)) >> 8)) * v) >> 8;
+            c.g = ((255 - ((s * (255 - c.g)) >> 8)) * v) >> 8;
+            c.b = ((255 - ((s * (255 - c.b)) >> 8)) * v) >> 8;
+        }
+        ws2812_put(strip, start + i, c.r, c.g, c.b);
+    }
+}
+
+void ws2812_fill_wheel(ws2812_t *strip, uint16_t start, uint16_t count,
+                       uint8_t pos, uint16_t pos_step) {
+    count = ws2812_clip_span(strip, start, count);
+
+    uint16_t p = pos << 8;  // 8.8 fixed-point wheel position
+    for (uint16_t i = 0; i < count; i++, p += pos_step) {
+        ws2812_pixel_t c = s_wheel_lut[p >> 8];
+        ws2812_put(strip, start + i, c.r, c.g, c.b);
+    }
+}
@@ -7,7 +7,20 @@ extern "C" {
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
+
+#ifdef WS2812_HOST
+#include "WS2812_host.h"
+#else
 #include "driver/rmt.h"
+#include "driver/spi_master.h"
+#endif
+
+// WS2812 timing specifications (in nanoseconds)
+#define WS2812_T0H_NS 400
+#define WS2812_T0L_NS 850
+#define WS2812_T1H_NS 800
+#define WS2812_T1L_NS 450
 
 typedef struct {
     uint8_t r;
@@ -15,23 +28,288 @@ typedef struct {
     uint8_t b;
 } ws2812_pixel_t;
 
+// Histogram buckets for stage timings: bucket 0 is < 128 us, each next one
+// doubles, the last one is >= 128 ms
+#define WS2812_HIST_BUCKETS 12
+
+// Min/avg/max and histogram of one pipeline stage
 typedef struct {
-    rmt_channel_t channel;
+    uint32_t count;
+    uint32_t min_us;
+    uint32_t max_us;
+    uint64_t total_us;            // avg = total_us / count
+    uint32_t hist[WS2812_HIST_BUCKETS];
+} ws2812_timing_t;
+
+// Frame statistics, sampled by ws2812_show(); heap figures, and the current
+// estimate while no limit is set, are sampled by ws2812_get_stats() and
+// ws2812_log_stats()
+typedef struct {
+    ws2812_timing_t encode;       // Pixel buffer to wire bytes
+    ws2812_timing_t transmit;     // Transport start to last segment done
+    ws2812_timing_t interval;     // Between consecutive ws2812_show() calls
+    uint32_t frames;              // Frames sent since init
+    uint32_t skipped_frames;      // Shows skipped because the frame was unchanged
+    uint32_t limited_frames;      // Frames scaled down to fit the current limit
+    uint32_t current_ma;          // Estimated draw before limiting; sampled on read when unlimited
+    uint16_t last_sent_pixels;    // Prefix length of the last transmitted frame
+    uint32_t last_show_us;        // Duration of the last ws2812_show() call
+    uint32_t max_show_us;         // Longest ws2812_show() call seen
+    size_t free_heap;             // Free heap when stats were last read
+    size_t min_largest_block;     // Smallest "largest free block" seen when stats were read
+} ws2812_stats_t;
+
+// Maximum number of outputs one strip can be split across (the ESP32-C3
+// has two RMT TX channels)
+#define WS2812_MAX_SEGMENTS 2
+
+// A contiguous run of pixels driven by its own output
+typedef struct {
+    int channel;                  // Transport specific: RMT channel, SPI host
     gpio_num_t gpio;
+    uint16_t start;               // First pixel of the run in the pixel buffer
+    uint16_t count;
+    uint16_t send_pixels;         // Prefix of the run sent by the current frame
+} ws2812_segment_t;
+
+// Pixel buffer layout
+typedef enum {
+    WS2812_FORMAT_RGB,            // ws2812_pixel_t, colour corrected while encoding
+    WS2812_FORMAT_NATIVE,         // Colour-corrected GRB wire bytes, copied as-is
+    WS2812_FORMAT_PALETTE,        // One byte per pixel indexing the strip's palette
+} ws2812_format_t;
+
+// Entries in a palette format strip's palette
+#define WS2812_PALETTE_SIZE 256
+
+// Palette of a palette format strip, allocated by ws2812_set_format() and
+// freed when the strip leaves palette format
+typedef struct {
+    ws2812_pixel_t entries[WS2812_PALETTE_SIZE];
+    uint8_t wire[WS2812_PALETTE_SIZE][3];   // Entries as corrected, post-processed GRB bytes
+    uint16_t load[WS2812_PALETTE_SIZE];     // Corrected channel sum of each entry
+} ws2812_palette_t;
+
+typedef struct ws2812_t ws2812_t;
+
+// Called once per ws2812_show_async() when the frame has finished clocking
+// out, from interrupt context; for a frame skipped because nothing changed,
+// straight from ws2812_show_async() in the calling task
+typedef void (*ws2812_done_cb_t)(ws2812_t *strip, void *arg);
+
+// Transport backend that clocks encoded GRB bytes out to the LEDs.
+// ws2812_show_async() calls start() once per segment and never blocks on it;
+// the backend calls ws2812_transport_done() once per segment when finished.
+typedef struct {
+    const char *name;
+    // Start sending len GRB bytes for segment seg; data stays valid until done
+    esp_err_t (*start)(ws2812_t *strip, uint8_t seg, const uint8_t *data, size_t len);
+    // Wait for segment seg's transfer to finish; ESP_ERR_TIMEOUT on timeout
+    esp_err_t (*wait)(ws2812_t *strip, uint8_t seg, TickType_t timeout);
+    // Release backend resources
+    void (*deinit)(ws2812_t *strip);
+} ws2812_transport_t;
+
+struct ws2812_t {
+    const ws2812_transport_t *transport;
+    void *transport_ctx;          // Backend private state
+    ws2812_segment_t segments[WS2812_MAX_SEGMENTS];
+    uint8_t segment_count;
     uint16_t pixel_count;
+    ws2812_format_t format;
     ws2812_pixel_t *pixels;
+    uint8_t *native;              // Same memory as pixels, as GRB bytes (native format)
+    uint8_t *indices;             // Same memory as pixels, as palette indices (palette format)
+    ws2812_palette_t *palette;    // Palette format only, NULL otherwise
+    uint16_t palette_fixed;       // Entries set by ws2812_set_palette(), kept by ws2812_clear()
+    uint16_t palette_used;        // Entries in use; ws2812_set_pixel() appends new colours
+    uint8_t palette_hit;          // Entry matched by the last ws2812_set_pixel()
+    bool palette_dirty;           // palette->wire and palette->load need rebuilding
     uint8_t brightness;
-} ws2812_t;
+    float gamma;
+    uint8_t white_balance[3];     // R, G, B scale (255 = unchanged)
+    uint8_t gamma_lut[256];       // Gamma curve, rebuilt by ws2812_set_gamma()
+    uint8_t lut_r[256];           // Brightness x gamma x white balance per channel,
+    uint8_t lut_g[256];           // rebuilt whenever one of them changes
+    uint8_t lut_b[256];
+    uint8_t fade;                 // Post-process: global level (255 = unchanged)
+    uint8_t flash;                // Post-process: mix towards full white (0 = none)
+    bool invert;                  // Post-process: invert each channel's output
+    uint8_t tint[3];              // Post-process: R, G, B scale (255 = unchanged)
+    bool post_active;             // Any post-process stage differs from its default
+    uint8_t post_r[256];          // Post-process per channel, corrected byte in, wire byte out
+    uint8_t post_g[256];
+    uint8_t post_b[256];
+    uint8_t out_r[256];           // lut_* followed by post_*, what RGB pixels encode through
+    uint8_t out_g[256];
+    uint8_t out_b[256];
+    uint8_t *wire;                // Brightness-scaled GRB bytes being sent, sized once in ws2812_init();
+    size_t wire_len;              // also the shadow copy of the last transmitted frame
+    bool force_refresh;           // Send the next frame even if it is unchanged
+    uint16_t dirty_end;           // One past the highest pixel written since the last show
+    uint32_t load;                // Sum of corrected channel values, kept up to date as pixels are set
+    uint32_t current_limit_ma;    // Current budget, 0 = unlimited
+    uint16_t limit_scale;         // Scale applied to the last frame (256 = none)
+    bool tx_pending;              // A frame was started and not yet waited for
+    volatile uint8_t tx_active;   // Segments still clocking out the current frame
+    volatile int64_t tx_end_us;   // esp_timer time the last transfer finished
+    int64_t tx_start_us;          // esp_timer time the pending transfer started
+    int64_t last_show_us;         // esp_timer time of the previous ws2812_show()
+    ws2812_done_cb_t done_cb;
+    void *done_arg;
+    ws2812_stats_t stats;
+};
 
+#ifndef WS2812_HOST
 // Initialize WS2812 LED strip
 ws2812_t* ws2812_init(uint16_t pixel_count, gpio_num_t gpio, rmt_channel_t channel);
 
+// Initialize a strip split into equal runs, one per GPIO/RMT channel pair,
+// transmitted simultaneously. Pixel indices stay contiguous: run n starts at
+// n * (pixel_count / segment_count).
+ws2812_t* ws2812_init_multi(uint16_t pixel_count, const gpio_num_t *gpios,
+                           const rmt_channel_t *channels, uint8_t segment_count);
+
+// Initialize a strip driven by SPI MOSI through GDMA instead of RMT
+ws2812_t* ws2812_init_spi(uint16_t pixel_count, gpio_num_t gpio, spi_host_device_t host);
+#endif
+
+// One encoded WS2812 bit as it appears on the wire
+typedef struct {
+    uint16_t high_ns;
+    uint16_t low_ns;
+} ws2812_symbol_t;
+
+// What the capture transport saw for the last frame
+typedef struct {
+    uint8_t *bytes;               // GRB bytes sent, pixel_count * 3 capacity
+    size_t len;                   // Bytes in the last frame (prefix length * 3)
+    ws2812_symbol_t *symbols;     // One per bit of bytes, MSB first
+    size_t symbol_count;
+    uint32_t frames;              // Frames captured since init
+    uint64_t total_bytes;         // Bytes captured since init
+} ws2812_capture_t;
+
+// Initialize a strip whose transport records frames in memory instead of
+// driving hardware; builds on the host with -DWS2812_HOST
+ws2812_t* ws2812_init_capture(uint16_t pixel_count);
+
+// Frames recorded by a strip from ws2812_init_capture(), NULL otherwise
+const ws2812_capture_t* ws2812_get_capture(ws2812_t *strip);
+
+// Allocate a strip and its buffers for a transport backend. The backend then
+// fills in segments[].channel/gpio, transport and transport_ctx.
+ws2812_t* ws2812_alloc(uint16_t pixel_count, uint8_t segment_count);
+
+// Called by transport backends (possibly from an ISR) when a segment is done
+void ws2812_transport_done(ws2812_t *strip);
+
 // Free WS2812 resources
 void ws2812_free(ws2812_t *strip);
 
 // Set brightness (0-255)
 void ws2812_set_brightness(ws2812_t *strip, uint8_t brightness);
 
+// Set gamma exponent applied before brightness (1.0 = linear, the default)
+void ws2812_set_gamma(ws2812_t *strip, float gamma);
+
+// Set per-channel white balance scale (255 = unchanged)
+void ws2812_set_white_balance(ws2812_t *strip, uint8_t r, uint8_t g, uint8_t b);
+
+// Switch pixel buffer layout. In native format ws2812_set_pixel() stores
+// brightness/gamma/white-balance corrected GRB bytes, so showing a frame is a
+// straight copy; table changes then only affect pixels set afterwards and
+// ws2812_get_pixel() returns corrected values. Palette format stores one byte
+// per pixel, resolved through the palette while encoding; the pixel buffer
+// shrinks to match. Current contents are converted.
+void ws2812_set_format(ws2812_t *strip, ws2812_format_t format);
+
+// Post-process applied to whatever is in the pixel buffer when the frame is
+// encoded, folded into the output tables so it costs no more than a plain
+// show. Stages run invert, flash, then tint and fade. Changing any of them
+// takes effect on the next ws2812_show() without redrawing the frame; they
+// stay in force until set back to their defaults.
+
+// Scale the whole frame (255 = unchanged, 0 = black)
+void ws2812_set_fade(ws2812_t *strip, uint8_t level);
+
+// Mix the whole frame towards full white (0 = none, 255 = all white)
+void ws2812_set_flash(ws2812_t *strip, uint8_t level);
+
+// Invert every channel: black shows at full output and vice versa
+void ws2812_set_invert(ws2812_t *strip, bool invert);
+
+// Scale each channel of the whole frame (255, 255, 255 = unchanged)
+void ws2812_set_tint(ws2812_t *strip, uint8_t r, uint8_t g, uint8_t b);
+
+// Set palette entry for palette format strips. Entries set this way stay
+// put across ws2812_clear(), and every pixel showing one picks up the new
+// colour on the next ws2812_show() without being redrawn. Entry 0 is what
+// ws2812_clear() fills with (black by default). Ignored in other formats;
+// the palette starts over each time a strip switches to palette format.
+void ws2812_set_palette(ws2812_t *strip, uint8_t entry, uint8_t r, uint8_t g, uint8_t b);
+
+// Palette entry for a colour, for ws2812_set_pixel() on palette format
+// strips: an existing entry, else a newly appended one (dropped again by
+// ws2812_clear()), else the nearest entry once the palette is full
+uint8_t ws2812_palette_match(ws2812_t *strip, uint8_t r, uint8_t g, uint8_t b);
+
+// Set pixel to a palette entry (palette format only)
+void ws2812_set_pixel_index(ws2812_t *strip, uint16_t index, uint8_t entry);
+
+// Cap the estimated supply current (0 = unlimited). Frames whose estimate
+// exceeds the budget are scaled down while encoding; others are untouched.
+void ws2812_set_current_limit(ws2812_t *strip, uint32_t milliamps);
+
+// Estimated current draw of the pixel buffer as it stands, after
+// post-processing, in milliamps
+uint32_t ws2812_estimate_current(ws2812_t *strip);
+
+// Unchecked ws2812_set_pixel_index()
+static inline void ws2812_put_index(ws2812_t *strip, uint16_t index, uint8_t entry) {
+    uint8_t *slot = strip->indices + index;
+    if (!strip->palette_dirty) {
+        strip->load += strip->palette->load[entry] - strip->palette->load[*slot];
+    }
+    *slot = entry;
+    if (index >= strip->dirty_end) {
+        strip->dirty_end = index + 1;
+    }
+}
+
+// Unchecked ws2812_set_pixel(): index must be below pixel_count. Inline so
+// drawing code can fill spans in a tight loop after clipping them once.
+// Keeps the current estimate in step by swapping the old pixel's corrected
+// channel sum for the new one.
+static inline void ws2812_put(ws2812_t *strip, uint16_t index, uint8_t r, uint8_t g, uint8_t b) {
+    if (strip->format == WS2812_FORMAT_PALETTE) {
+        ws2812_put_index(strip, index, ws2812_palette_match(strip, r, g, b));
+        return;
+    }
+
+    uint8_t cg = strip->lut_g[g];
+    uint8_t cr = strip->lut_r[r];
+    uint8_t cb = strip->lut_b[b];
+
+    if (strip->format == WS2812_FORMAT_NATIVE) {
+        uint8_t *bytes = strip->native + index * 3;
+        strip->load += (cg + cr + cb) - (bytes[0] + bytes[1] + bytes[2]);
+        bytes[0] = cg;
+        bytes[1] = cr;
+        bytes[2] = cb;
+    } else {
+        ws2812_pixel_t *pixel = &strip->pixels[index];
+        strip->load += (cg + cr + cb) -
+                       (strip->lut_r[pixel->r] + strip->lut_g[pixel->g] + strip->lut_b[pixel->b]);
+        pixel->r = r;
+        pixel->g = g;
+        pixel->b = b;
+    }
+    if (index >= strip->dirty_end) {
+        strip->dirty_end = index + 1;
+    }
+}
+
 // Set pixel color
 void ws2812_set_pixel(ws2812_t *strip, uint16_t index, uint8_t r, uint8_t g, uint8_t b);
 
@@ -44,17 +322,67 @@ ws2812_pixel_t ws2812_get_pixel(ws2812_t *strip, uint16_t index);
 // Clear all pixels
 void ws2812_clear(ws2812_t *strip);
 
-// Send data to LEDs
+// Send data to LEDs and wait for the transfer to finish
 void ws2812_show(ws2812_t *strip);
 
+// Encode the pixel buffer and start sending it without waiting. Frames that
+// encode to exactly what was last sent are skipped, otherwise only the
+// prefix up to the last changed pixel is sent (the rest of the chain keeps
+// what it latched last time). The pixel buffer (back) is free to draw the
+// next frame as soon as this returns; the GRB wire bytes (front) are owned
+// by the transfer until it completes.
+// Waits for the previous frame first if it is still in flight.
+void ws2812_show_async(ws2812_t *strip);
+
+// The encode step of ws2812_show_async() for one segment, exposed for
+// benchmarks: writes pixels [seg->start, end) into the wire buffer scaled by
+// scale/256 and returns the changed prefix length. The wire buffer must not
+// be in flight.
+uint16_t ws2812_encode_segment(ws2812_t *strip, const ws2812_segment_t *seg, uint16_t end,
+                               uint16_t scale);
+
+// Resend the next frame even if it matches the last one (glitch recovery)
+void ws2812_force_refresh(ws2812_t *strip);
+
+// Wait for the frame started by ws2812_show_async(); false on timeout
+bool ws2812_wait(ws2812_t *strip, TickType_t timeout);
+
+// Poll whether a frame is still clocking out
+bool ws2812_is_busy(ws2812_t *strip);
+
+// Register a completion callback (usually runs in ISR context, keep it
+// short, e.g. vTaskNotifyGiveFromISR). Skipped frames notify too, so every
+// ws2812_show_async() can be paired with one wait. Pass NULL to remove.
+void ws2812_set_done_callback(ws2812_t *strip, ws2812_done_cb_t cb, void *arg);
+
+// Copy out frame statistics
+void ws2812_get_stats(ws2812_t *strip, ws2812_stats_t *stats);
+
+// Start a new statistics window (frame counters and heap watermark are kept)
+void ws2812_reset_stats(ws2812_t *strip);
+
+// Print frame statistics to the log
+void ws2812_log_stats(ws2812_t *strip);
+
 // Helper function to create color from HSV
 ws2812_pixel_t ws2812_hsv_to_rgb(uint8_t h, uint8_t s, uint8_t v);
 
 // Helper function for rainbow effect
 ws2812_pixel_t ws2812_wheel(uint8_t pos);
 
+// Fill count pixels from start with an HSV hue ramp. hue_step is in 1/256ths
+// of a hue unit per pixel (256 = one hue step per pixel). Uses a precomputed
+// hue table, so results can differ from ws2812_hsv_to_rgb() by rounding.
+void ws2812_fill_hsv_gradient(ws2812_t *strip, uint16_t start, uint16_t count,
+                              uint8_t hue, uint16_t hue_step, uint8_t s, uint8_t v);
+
+// Fill count pixels from start with colour wheel positions; pos_step is in
+// 1/256ths of a wheel position per pixel
+void ws2812_fill_wheel(ws2812_t *strip, uint16_t start, uint16_t count,
+                       uint8_t pos, uint16_t pos_step);
+
 #ifdef __cplusplus
 }
 #endif
 
-#endif // WS2812_H
\ No newline at end of file
+#endif // WS2812_H
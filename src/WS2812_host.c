@@ -0,0 +1,98 @@
+#include "WS2812.h"
+#include "WS2812_symbols.h"
+#include <stdlib.h>
+#include <string.h>
+#ifndef WS2812_HOST
+#include "esp_log.h"
+#endif
+
+#define TAG "WS2812_CAPTURE"
+
+// Capture transport: records every frame handed to it, both as GRB bytes and
+// as the symbol timing a hardware backend would put on the wire, decoded from
+// the same symbol table the RMT translator sends. Completes immediately, so
+// ws2812_show() never blocks.
+
+static esp_err_t ws2812_capture_start(ws2812_t *strip, uint8_t seg, const uint8_t *data, size_t len) {
+    ws2812_capture_t *capture = (ws2812_capture_t*)strip->transport_ctx;
+
+    // Segments of one frame land at their offset in the captured frame
+    size_t offset = strip->segments[seg].start * 3;
+    memcpy(capture->bytes + offset, data, len);
+    for (size_t i = 0; i < len; i++) {
+        const uint32_t *symbols = ws2812_symbol_lut[data[i]];
+        for (int bit = 0; bit < 8; bit++) {
+            capture->symbols[(offset + i) * 8 + bit] = ws2812_symbol_decode(symbols[bit]);
+        }
+    }
+
+    if (seg == 0) {
+        capture->frames++;
+        capture->len = 0;
+    }
+    if (offset + len > capture->len) {
+        capture->len = offset + len;
+        capture->symbol_count = capture->len * 8;
+    }
+    capture->total_bytes += len;
+
+    ws2812_transport_done(strip);
+    return ESP_OK;
+}
+
+static esp_err_t ws2812_capture_wait(ws2812_t *strip, uint8_t seg, TickType_t timeout) {
+    (void)strip;
+    (void)seg;
+    (void)timeout;
+    return ESP_OK;
+}
+
+static void ws2812_capture_deinit(ws2812_t *strip) {
+    ws2812_capture_t *capture = (ws2812_capture_t*)strip->transport_ctx;
+    if (!capture) return;
+
+    free(capture->bytes);
+    free(capture->symbols);
+    free(capture);
+    strip->transport_ctx = NULL;
+}
+
+static const ws2812_transport_t ws2812_capture_transport = {
+    .name = "capture",
+    .start = ws2812_capture_start,
+    .wait = ws2812_capture_wait,
+    .deinit = ws2812_capture_deinit,
+};
+
+ws2812_t* ws2812_init_capture(uint16_t pixel_count) {
+    ws2812_t *strip = ws2812_alloc(pixel_count, 1);
+    if (!strip) {
+        return NULL;
+    }
+
+    ws2812_capture_t *capture = (ws2812_capture_t*)calloc(1, sizeof(ws2812_capture_t));
+    if (!capture) {
+        ESP_LOGE(TAG, "Failed to allocate capture state");
+        ws2812_free(strip);
+        return NULL;
+    }
+    strip->transport_ctx = capture;
+    strip->transport = &ws2812_capture_transport;
+
+    capture->bytes = (uint8_t*)calloc(strip->wire_len, 1);
+    capture->symbols = (ws2812_symbol_t*)calloc(strip->wire_len * 8, sizeof(ws2812_symbol_t));
+    if (!capture->bytes || !capture->symbols) {
+        ESP_LOGE(TAG, "Failed to allocate capture buffers");
+        ws2812_free(strip);
+        return NULL;
+    }
+
+    return strip;
+}
+
+const ws2812_capture_t* ws2812_get_capture(ws2812_t *strip) {
+    if (!strip || strip->transport != &ws2812_capture_transport) {
+        return NULL;
+    }
+    return (const ws2812_capture_t*)strip->transport_ctx;
+}
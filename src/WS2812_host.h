@@ -0,0 +1,61 @@
+#ifndef WS2812_HOST_H
+#define WS2812_HOST_H
+
+// Stand-ins for the ESP-IDF and FreeRTOS pieces the core driver uses, so
+// WS2812.c and WS2812_host.c build on a Linux host with -DWS2812_HOST
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+typedef int esp_err_t;
+#define ESP_OK 0
+#define ESP_FAIL -1
+#define ESP_ERR_TIMEOUT 0x107
+
+typedef int gpio_num_t;
+
+typedef uint32_t TickType_t;
+#define portMAX_DELAY 0xffffffffu
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+
+#define IRAM_ATTR
+#define DRAM_ATTR
+
+#define ESP_LOGE(tag, fmt, ...) fprintf(stderr, "E %s: " fmt "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGW(tag, fmt, ...) fprintf(stderr, "W %s: " fmt "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGI(tag, fmt, ...) fprintf(stderr, "I %s: " fmt "\n", tag, ##__VA_ARGS__)
+
+#define MALLOC_CAP_8BIT 0
+
+static inline int64_t esp_timer_get_time(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+// Cycle counter for the benchmarks in test/: the time-stamp counter on x86,
+// elsewhere nanoseconds. Wraps like the target's 32-bit counter, so time
+// spans well under a second.
+static inline uint32_t esp_cpu_get_cycle_count(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return (uint32_t)__builtin_ia32_rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec);
+#endif
+}
+
+// Heap introspection is not available; report zero
+static inline size_t heap_caps_get_free_size(uint32_t caps) {
+    (void)caps;
+    return 0;
+}
+
+static inline size_t heap_caps_get_largest_free_block(uint32_t caps) {
+    (void)caps;
+    return 0;
+}
+
+#endif // WS2812_HOST_H
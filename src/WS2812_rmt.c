@@ -0,0 +1,115 @@
+#include "WS2812.h"
+#include "WS2812_symbols.h"
+#include "esp_log.h"
+#include "esp_attr.h"
+#include "freertos/FreeRTOS.h"
+
+#define TAG "WS2812_RMT"
+
+// Strips by RMT channel, for routing the shared tx-end interrupt callback
+static ws2812_t *s_strips[RMT_CHANNEL_MAX];
+
+static void ws2812_rmt_tx_end(rmt_channel_t channel, void *arg) {
+    ws2812_transport_done(s_strips[channel]);
+}
+
+// RMT translator: expands GRB bytes into symbols as the driver refills the
+// channel memory, so the full frame is never materialized as rmt_item32_t
+static void IRAM_ATTR ws2812_rmt_translate(const void *src, rmt_item32_t *dest, size_t src_size,
+                                           size_t wanted_num, size_t *translated_size, size_t *item_num) {
+    if (!src || !dest) {
+        *translated_size = 0;
+        *item_num = 0;
+        return;
+    }
+
+    const uint8_t *byte = (const uint8_t*)src;
+    size_t size = 0;
+    size_t num = 0;
+    while (size < src_size && num + 8 <= wanted_num) {
+        const uint32_t *symbols = ws2812_symbol_lut[*byte];
+        for (int bit = 0; bit < 8; bit++) {
+            dest[bit].val = symbols[bit];
+        }
+        dest += 8;
+        num += 8;
+        byte++;
+        size++;
+    }
+
+    *translated_size = size;
+    *item_num = num;
+}
+
+static esp_err_t ws2812_rmt_start(ws2812_t *strip, uint8_t seg, const uint8_t *data, size_t len) {
+    // The translator turns bytes into RMT symbols as the driver refills
+    // channel memory from its ISR
+    return rmt_write_sample((rmt_channel_t)strip->segments[seg].channel, data, len, false);
+}
+
+static esp_err_t ws2812_rmt_wait(ws2812_t *strip, uint8_t seg, TickType_t timeout) {
+    return rmt_wait_tx_done((rmt_channel_t)strip->segments[seg].channel, timeout);
+}
+
+static void ws2812_rmt_deinit(ws2812_t *strip) {
+    for (int s = 0; s < strip->segment_count; s++) {
+        rmt_channel_t channel = (rmt_channel_t)strip->segments[s].channel;
+#if SOC_RMT_SUPPORT_TX_SYNCHRO
+        if (strip->segment_count > 1) {
+            rmt_remove_channel_from_group(channel);
+        }
+#endif
+        s_strips[channel] = NULL;
+        rmt_driver_uninstall(channel);
+    }
+}
+
+static const ws2812_transport_t ws2812_rmt_transport = {
+    .name = "rmt",
+    .start = ws2812_rmt_start,
+    .wait = ws2812_rmt_wait,
+    .deinit = ws2812_rmt_deinit,
+};
+
+ws2812_t* ws2812_init(uint16_t pixel_count, gpio_num_t gpio, rmt_channel_t channel) {
+    return ws2812_init_multi(pixel_count, &gpio, &channel, 1);
+}
+
+ws2812_t* ws2812_init_multi(uint16_t pixel_count, const gpio_num_t *gpios,
+                           const rmt_channel_t *channels, uint8_t segment_count) {
+    ws2812_t *strip = ws2812_alloc(pixel_count, segment_count);
+    if (!strip) {
+        return NULL;
+    }
+
+    for (int s = 0; s < segment_count; s++) {
+        ws2812_segment_t *seg = &strip->segments[s];
+        seg->channel = channels[s];
+        seg->gpio = gpios[s];
+
+        // Configure RMT
+        rmt_config_t config = RMT_DEFAULT_CONFIG_TX(gpios[s], channels[s]);
+        config.clk_div = 2;  // 40MHz clock
+        config.mem_block_num = 1;
+
+        ESP_ERROR_CHECK(rmt_config(&config));
+        ESP_ERROR_CHECK(rmt_driver_install(channels[s], 0, 0));
+        ESP_ERROR_CHECK(rmt_translator_init(channels[s], ws2812_rmt_translate));
+
+#if SOC_RMT_SUPPORT_TX_SYNCHRO
+        // Grouped channels start clocking out together
+        if (segment_count > 1) {
+            ESP_ERROR_CHECK(rmt_add_channel_to_group(channels[s]));
+        }
+#endif
+
+        // The tx-end callback is global to the RMT driver; route it per channel
+        s_strips[channels[s]] = strip;
+
+        ESP_LOGI(TAG, "WS2812 initialized: %d pixels on GPIO %d", seg->count, seg->gpio);
+    }
+    rmt_register_tx_end_callback(ws2812_rmt_tx_end, NULL);
+
+    strip->transport = &ws2812_rmt_transport;
+    return strip;
+}
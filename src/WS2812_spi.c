@@ -0,0 +1,158 @@
+#include "WS2812.h"
+#include <stdlib.h>
+#include <string.h>
+#include "esp_log.h"
+#include "esp_attr.h"
+#include "esp_heap_caps.h"
+#include "freertos/FreeRTOS.h"
+
+#define TAG "WS2812_SPI"
+
+// Each WS2812 bit goes out as 3 SPI bits at 2.4 MHz (417 ns per SPI bit):
+// 0 -> 100 (417 ns high, 833 ns low), 1 -> 110 (833 ns high, 417 ns low)
+#define WS2812_SPI_CLOCK_HZ 2400000
+#define WS2812_SPI_BYTES_PER_BYTE 3
+
+// Low tail that holds the line down for the reset latch (20 bytes = 66 us)
+#define WS2812_SPI_RESET_BYTES 20
+
+typedef struct {
+    spi_host_device_t host;
+    spi_device_handle_t device;
+    uint8_t *dma_buf;             // Encoded frame plus reset tail, DMA capable
+    size_t dma_len;
+    spi_transaction_t trans;
+    bool queued;                  // A transaction is waiting to be collected
+} ws2812_spi_ctx_t;
+
+// 24 SPI bits for every byte value, built on first init
+static uint32_t s_spi_lut[256];
+static bool s_spi_lut_ready = false;
+
+static void ws2812_spi_build_lut(void) {
+    for (int v = 0; v < 256; v++) {
+        uint32_t bits = 0;
+        for (int bit = 7; bit >= 0; bit--) {
+            bits = (bits << 3) | ((v & (1 << bit)) ? 0x6 : 0x4);
+        }
+        s_spi_lut[v] = bits;
+    }
+    s_spi_lut_ready = true;
+}
+
+static void IRAM_ATTR ws2812_spi_post(spi_transaction_t *trans) {
+    ws2812_transport_done((ws2812_t*)trans->user);
+}
+
+static esp_err_t ws2812_spi_start(ws2812_t *strip, uint8_t seg, const uint8_t *data, size_t len) {
+    ws2812_spi_ctx_t *ctx = (ws2812_spi_ctx_t*)strip->transport_ctx;
+
+    // Expand into the DMA buffer; the CPU is free once the transfer is queued
+    uint8_t *out = ctx->dma_buf;
+    for (size_t i = 0; i < len; i++) {
+        uint32_t bits = s_spi_lut[data[i]];
+        *out++ = bits >> 16;
+        *out++ = bits >> 8;
+        *out++ = bits;
+    }
+    memset(out, 0, WS2812_SPI_RESET_BYTES);
+
+    memset(&ctx->trans, 0, sizeof(ctx->trans));
+    ctx->trans.length = (len * WS2812_SPI_BYTES_PER_BYTE + WS2812_SPI_RESET_BYTES) * 8;
+    ctx->trans.tx_buffer = ctx->dma_buf;
+    ctx->trans.user = strip;
+
+    esp_err_t err = spi_device_queue_trans(ctx->device, &ctx->trans, portMAX_DELAY);
+    if (err == ESP_OK) {
+        ctx->queued = true;
+    }
+    return err;
+}
+
+static esp_err_t ws2812_spi_wait(ws2812_t *strip, uint8_t seg, TickType_t timeout) {
+    ws2812_spi_ctx_t *ctx = (ws2812_spi_ctx_t*)strip->transport_ctx;
+    if (!ctx->queued) return ESP_OK;
+
+    spi_transaction_t *done;
+    esp_err_t err = spi_device_get_trans_result(ctx->device, &done, timeout);
+    if (err == ESP_OK) {
+        ctx->queued = false;
+    }
+    return err;
+}
+
+static void ws2812_spi_deinit(ws2812_t *strip) {
+    ws2812_spi_ctx_t *ctx = (ws2812_spi_ctx_t*)strip->transport_ctx;
+    if (!ctx) return;
+
+    if (ctx->device) {
+        spi_bus_remove_device(ctx->device);
+        spi_bus_free(ctx->host);
+    }
+    if (ctx->dma_buf) {
+        heap_caps_free(ctx->dma_buf);
+    }
+    free(ctx);
+    strip->transport_ctx = NULL;
+}
+
+static const ws2812_transport_t ws2812_spi_transport = {
+    .name = "spi",
+    .start = ws2812_spi_start,
+    .wait = ws2812_spi_wait,
+    .deinit = ws2812_spi_deinit,
+};
+
+ws2812_t* ws2812_init_spi(uint16_t pixel_count, gpio_num_t gpio, spi_host_device_t host) {
+    ws2812_t *strip = ws2812_alloc(pixel_count, 1);
+    if (!strip) {
+        return NULL;
+    }
+    strip->segments[0].channel = host;
+    strip->segments[0].gpio = gpio;
+
+    if (!s_spi_lut_ready) {
+        ws2812_spi_build_lut();
+    }
+
+    ws2812_spi_ctx_t *ctx = (ws2812_spi_ctx_t*)calloc(1, sizeof(ws2812_spi_ctx_t));
+    if (!ctx) {
+        ESP_LOGE(TAG, "Failed to allocate SPI transport state");
+        ws2812_free(strip);
+        return NULL;
+    }
+    ctx->host = host;
+    strip->transport_ctx = ctx;
+    strip->transport = &ws2812_spi_transport;
+
+    ctx->dma_len = strip->wire_len * WS2812_SPI_BYTES_PER_BYTE + WS2812_SPI_RESET_BYTES;
+    ctx->dma_buf = (uint8_t*)heap_caps_malloc(ctx->dma_len, MALLOC_CAP_DMA);
+    if (!ctx->dma_buf) {
+        ESP_LOGE(TAG, "Failed to allocate SPI DMA buffer");
+        ws2812_free(strip);
+        return NULL;
+    }
+
+    // MOSI only; clock and chip select are not routed to pins
+    spi_bus_config_t bus_config = {
+        .mosi_io_num = gpio,
+        .miso_io_num = -1,
+        .sclk_io_num = -1,
+        .quadwp_io_num = -1,
+        .quadhd_io_num = -1,
+        .max_transfer_sz = (int)ctx->dma_len,
+    };
+    ESP_ERROR_CHECK(spi_bus_initialize(host, &bus_config, SPI_DMA_CH_AUTO));
+
+    spi_device_interface_config_t dev_config = {
+        .mode = 0,
+        .clock_speed_hz = WS2812_SPI_CLOCK_HZ,
+        .spics_io_num = -1,
+        .queue_size = 1,
+        .post_cb = ws2812_spi_post,
+    };
+    ESP_ERROR_CHECK(spi_bus_add_device(host, &dev_config, &ctx->device));
+
+    ESP_LOGI(TAG, "WS2812 initialized: %d pixels on GPIO %d (SPI)", pixel_count, gpio);
+    return strip;
+}
@@ -0,0 +1,37 @@
+#ifndef WS2812_SYMBOLS_H
+#define WS2812_SYMBOLS_H
+
+#include <stdint.h>
+#include "WS2812.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// RMT symbols at 40MHz (25ns per tick): duration0 in bits 0-14, level0 in
+// bit 15, duration1 in bits 16-30, level1 in bit 31
+#define WS2812_RMT_TICK_NS 25
+#define WS2812_RMT_BIT0 ((WS2812_T0H_NS / WS2812_RMT_TICK_NS) | (1u << 15) | \
+                         ((uint32_t)(WS2812_T0L_NS / WS2812_RMT_TICK_NS) << 16))
+#define WS2812_RMT_BIT1 ((WS2812_T1H_NS / WS2812_RMT_TICK_NS) | (1u << 15) | \
+                         ((uint32_t)(WS2812_T1L_NS / WS2812_RMT_TICK_NS) << 16))
+
+// Eight ready-made symbols for every byte value, MSB first, as the RMT
+// translator copies them out. Shared with the capture transport so host
+// builds record exactly what goes on the wire.
+extern const uint32_t ws2812_symbol_lut[256][8];
+
+// Wire timing of one table symbol
+static inline ws2812_symbol_t ws2812_symbol_decode(uint32_t symbol) {
+    ws2812_symbol_t decoded = {
+        (uint16_t)((symbol & 0x7fff) * WS2812_RMT_TICK_NS),
+        (uint16_t)(((symbol >> 16) & 0x7fff) * WS2812_RMT_TICK_NS),
+    };
+    return decoded;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WS2812_SYMBOLS_H
@@ -1,7 +1,6 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
-#include <cmath>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "esp_system.h"
@@ -10,6 +9,13 @@
 #include "driver/gpio.h"
 #include "driver/i2c.h"
 #include "WS2812.h"
+#include "LedLayout.h"
+#include "Framebuffer.h"
+#include "Sprite.h"
+#include "Compositor.h"
+#include "Font.h"
+#include "Transitions.h"
+#include "FixedPoint.h"
 #include "VL53L0X.h"
 
 #define TAG "LED_GAME"
@@ -20,8 +26,33 @@
 #define LED_COUNT (MATRIX_WIDTH * MATRIX_HEIGHT)
 #define LED_PIN GPIO_NUM_10  // Changed from GPIO_NUM_2 based on your setup
 #define BRIGHTNESS 50
+#define GAMMA 2.2f
+#define LED_CURRENT_LIMIT_MA 3000   // Supply budget for the matrix, 0 = unlimited
+#define LED_PALETTE 0    // Store pixels as 8-bit palette indices (saves RAM, quantizes colours)
 #define RMT_CHANNEL RMT_CHANNEL_0
 
+// Split output: drive rows 0-7 and rows 8-15 as two chains on two GPIOs,
+// clocked out simultaneously to halve frame wire time. The second chain's
+// data input must be wired to the first LED of row 8.
+#define LED_SPLIT_OUTPUT 0
+#define LED_PIN_2 GPIO_NUM_5
+#define RMT_CHANNEL_2 RMT_CHANNEL_1
+#define LED_SEGMENTS (LED_SPLIT_OUTPUT ? 2 : 1)
+
+// Drive the panel from SPI MOSI + GDMA instead of RMT (single output only)
+#define LED_USE_SPI 0
+#define LED_SPI_HOST SPI2_HOST
+
+// Panel wiring, see LedLayout.h. This panel's rows all run right to left.
+#define LED_WIRING LedWiring::Progressive
+#define LED_ROTATION 0      // Clockwise degrees: 0, 90, 180 or 270
+#define LED_MIRROR true
+
+// Each output drives a band of rows; the driver keeps the bands back to back
+// in the pixel buffer
+using MatrixLayout = LedLayout<MATRIX_WIDTH, MATRIX_HEIGHT, LED_WIRING, LED_ROTATION,
+                               LED_MIRROR, LED_SEGMENTS>;
+
 // I2C Configuration for ToF sensor
 #define I2C_MASTER_SCL_IO 9
 #define I2C_MASTER_SDA_IO 8
@@ -37,8 +68,27 @@ typedef enum {
     INVADERS
 } game_mode_t;
 
+typedef enum {
+    TRANSITION_RING,     // Ring expanding from the centre
+    TRANSITION_IRIS,     // Disc opening from the centre
+    TRANSITION_WIPE,     // Diagonal sweep from the top left
+    TRANSITION_SPIRAL    // Spiral winding out from the centre
+} transition_t;
+
 // Global variables
 static ws2812_t *strip = nullptr;
+static Framebuffer<MatrixLayout> fb;
+
+// Game screen layers, bottom to top. Static layers are drawn when a game
+// starts; the others only when what they show changes.
+enum {
+    LAYER_BACKGROUND,   // Scenery such as the Pong centre line
+    LAYER_PLAYFIELD,    // Paddles and baskets
+    LAYER_SPRITES,      // Balls and falling items
+    LAYER_HUD,          // Scores and lives
+    LAYER_COUNT
+};
+static Compositor<MatrixLayout, LAYER_COUNT> screen(fb);
 static VL53L0X *tof_sensor = nullptr;
 static uint16_t sensor_distance = 200;
 static game_mode_t current_mode = MENU;  // Start with menu
@@ -47,12 +97,23 @@ static int last_stable_selection = -1;
 static uint32_t selection_start_time = 0;
 static bool sensor_initialized = false;
 static bool tof_debug_mode = false;  // Set to true for detailed sensor output
+static bool led_stats_mode = false;  // Set to true to log LED driver timing every LED_STATS_INTERVAL_MS
 
 // Menu selection configuration
 #define MIN_SELECTION_DISTANCE 100  // Minimum distance for valid selection (mm)
 #define MAX_SELECTION_DISTANCE 350  // Maximum distance for valid selection (mm)
 #define SELECTION_HOLD_TIME 5000    // Time to hold selection to confirm (ms)
 
+#define LED_STATS_INTERVAL_MS 10000
+
+// Game loop timing. Games advance in fixed GAME_TICK_MS steps, the rate
+// their speeds are tuned for, however long a frame takes to draw and send.
+#define GAME_TICK_MS 50             // Simulation step (20 ticks per second)
+#define FRAME_MS 20                 // Shortest frame period, caps the loop at 50 FPS
+// FRAME_MS in whole scheduler ticks, rounded up so the cap is never exceeded
+#define FRAME_TICKS ((FRAME_MS + portTICK_PERIOD_MS - 1) / portTICK_PERIOD_MS)
+#define MAX_TICKS_PER_FRAME 4       // Ticks to catch up after a stall before dropping time
+
 // Function prototypes
 void init_hardware(void);
 void init_tof_sensor(void);
@@ -60,16 +121,21 @@ void clear_display(void);
 void set_pixel(int x, int y, uint8_t r, uint8_t g, uint8_t b);
 void show_display(void);
 uint16_t read_tof_sensor(void);
-int get_sensor_position(void);
+int get_sensor_position(uint16_t dist);
 void draw_menu(void);
 void print_game_legend(game_mode_t game);
 void test_matrix_mapping(void);
-void show_transition_screen(const char* text, uint8_t r, uint8_t g, uint8_t b, int duration_ms);
+void show_transition_screen(const char* text, uint8_t r, uint8_t g, uint8_t b, transition_t effect,
+                            int duration_ms);
 void show_game_over_screen(int score, int high_score);
-void run_pong(void);
-void run_flappy(void);
-void run_catch(void);
-void run_invaders(void);
+void run_pong(int sensor_pos);
+void run_flappy(int sensor_pos);
+void run_catch(int sensor_pos);
+void run_invaders(int sensor_pos);
+void render_pong(q8_8 alpha);
+void render_flappy(q8_8 alpha);
+void render_catch(q8_8 alpha);
+void render_invaders(void);
 
 void init_tof_sensor(void) {
     ESP_LOGI(TAG, "Initializing VL53L0X ToF sensor");
@@ -97,12 +163,26 @@ void init_hardware(void) {
     ESP_LOGI(TAG, "Initializing hardware...");
 
     // Initialize WS2812 LED strip
+#if LED_USE_SPI
+    strip = ws2812_init_spi(LED_COUNT, LED_PIN, LED_SPI_HOST);
+#elif LED_SPLIT_OUTPUT
+    const gpio_num_t pins[] = {LED_PIN, LED_PIN_2};
+    const rmt_channel_t channels[] = {RMT_CHANNEL, RMT_CHANNEL_2};
+    strip = ws2812_init_multi(LED_COUNT, pins, channels, LED_SEGMENTS);
+#else
     strip = ws2812_init(LED_COUNT, LED_PIN, RMT_CHANNEL);
+#endif
     if (!strip) {
         ESP_LOGE(TAG, "Failed to initialize WS2812 strip");
         return;
     }
+    fb = Framebuffer<MatrixLayout>(strip);
     ws2812_set_brightness(strip, BRIGHTNESS);
+    ws2812_set_gamma(strip, GAMMA);
+    ws2812_set_current_limit(strip, LED_CURRENT_LIMIT_MA);
+#if LED_PALETTE
+    ws2812_set_format(strip, WS2812_FORMAT_PALETTE);
+#endif
 
     // Initialize ToF sensor
     init_tof_sensor();
@@ -111,35 +191,21 @@ void init_hardware(void) {
 }
 
 void clear_display(void) {
-    ws2812_clear(strip);
+    fb.clear();
 }
 
 int get_index(int x, int y) {
-    if (x < 0 || x >= MATRIX_WIDTH || y < 0 || y >= MATRIX_HEIGHT) {
-        return -1;
-    }
-    return y * MATRIX_WIDTH + (MATRIX_WIDTH - 1 - x);
-
-    // Zigzag pattern for LED matrix
-    // Try flipping: even rows reversed, odd rows normal
-    if (y % 2 == 0) {
-        // Even rows (0, 2, 4...): right to left
-        return y * MATRIX_WIDTH + (MATRIX_WIDTH - 1 - x);
-    } else {
-        // Odd rows (1, 3, 5...): left to right
-        return y * MATRIX_WIDTH + x;
-    }
+    return MatrixLayout::index_checked(x, y);
 }
 
 void set_pixel(int x, int y, uint8_t r, uint8_t g, uint8_t b) {
-    int idx = get_index(x, y);
-    if (idx >= 0 && idx < LED_COUNT) {
-        ws2812_set_pixel(strip, idx, r, g, b);
-    }
+    fb.set(x, y, {r, g, b});
 }
 
 void show_display(void) {
-    ws2812_show(strip);
+    // Returns as soon as the frame is encoded; the next frame can be updated
+    // and drawn while this one is still clocking out
+    ws2812_show_async(strip);
 }
 
 uint16_t read_tof_sensor(void) {
@@ -170,12 +236,10 @@ uint16_t read_tof_sensor(void) {
         }
     }
 
-    // Fallback to simulated sensor movement for testing
-    static uint16_t sim_dist = 200;
-    static int dir = 1;
-    sim_dist += dir * 5;
-    if (sim_dist > 350) dir = -1;
-    if (sim_dist < 100) dir = 1;
+    // Fallback to simulated sensor movement for testing: sweep 100-350mm
+    // and back at 250mm/s, however often it is read
+    uint32_t phase = (esp_timer_get_time() / 20000) % 100;
+    uint16_t sim_dist = 100 + 5 * (phase < 50 ? phase : 100 - phase);
 
     if (reading_count++ % 10 == 0) {
         printf("ToF Simulated: %d mm (sensor not connected)\n", sim_dist);
@@ -184,8 +248,8 @@ uint16_t read_tof_sensor(void) {
     return sim_dist;
 }
 
-int get_sensor_position(void) {
-    uint16_t dist = read_tof_sensor();
+// Map a distance from read_tof_sensor() to a matrix row or column
+int get_sensor_position(uint16_t dist) {
     int pos = ((dist - 50) * 15) / 350;
     if (pos < 0) pos = 0;
     if (pos > 15) pos = 15;
@@ -202,20 +266,9 @@ int get_sensor_position(void) {
 
 void draw_rect(int x, int y, int w, int h, uint8_t r, uint8_t g, uint8_t b, bool filled) {
     if (filled) {
-        for (int i = 0; i < h; i++) {
-            for (int j = 0; j < w; j++) {
-                set_pixel(x + j, y + i, r, g, b);
-            }
-        }
+        fb.fill_rect(x, y, w, h, {r, g, b});
     } else {
-        for (int i = 0; i < w; i++) {
-            set_pixel(x + i, y, r, g, b);
-            set_pixel(x + i, y + h - 1, r, g, b);
-        }
-        for (int i = 0; i < h; i++) {
-            set_pixel(x, y + i, r, g, b);
-            set_pixel(x + w - 1, y + i, r, g, b);
-        }
+        fb.rect(x, y, w, h, {r, g, b});
     }
 }
 
@@ -404,6 +457,8 @@ void test_matrix_mapping(void) {
     printf("If mirrored, we'll need to adjust the mapping.\n\n");
 }
 
+static constexpr q16_16 MENU_DIM_LEVEL(0.3);   // Icon brightness when selection starts
+
 void draw_menu(void) {
     clear_display();
 
@@ -422,17 +477,17 @@ void draw_menu(void) {
 
         if (game == menu_selection && menu_selection != -1) {
             // Calculate brightness based on selection progress
-            float progress = 0;
+            q16_16 progress = 0;
             if (selection_start_time > 0) {
                 uint32_t elapsed = esp_timer_get_time() / 1000 - selection_start_time;
-                progress = (float)elapsed / SELECTION_HOLD_TIME;
-                if (progress > 1.0) progress = 1.0;
+                progress = fixed_clamp(q16_16::ratio(elapsed, SELECTION_HOLD_TIME), q16_16(0), q16_16(1));
             }
 
             // Interpolate between dim and full brightness
-            uint8_t r = (uint8_t)(colors[game][0] * (0.3 + 0.7 * progress));
-            uint8_t g = (uint8_t)(colors[game][1] * (0.3 + 0.7 * progress));
-            uint8_t b = (uint8_t)(colors[game][2] * (0.3 + 0.7 * progress));
+            q16_16 level = fixed_lerp(MENU_DIM_LEVEL, q16_16(1), progress);
+            uint8_t r = level.scale(colors[game][0]);
+            uint8_t g = level.scale(colors[game][1]);
+            uint8_t b = level.scale(colors[game][2]);
 
             draw_rect(x, y, 4, 4, r, g, b, true);
         } else {
@@ -446,13 +501,12 @@ void draw_menu(void) {
         int y = (menu_selection / 2) * 8;
 
         // Pulse the border brightness based on selection progress
-        float progress = 0;
+        q16_16 progress = 0;
         if (selection_start_time > 0) {
             uint32_t elapsed = esp_timer_get_time() / 1000 - selection_start_time;
-            progress = (float)elapsed / SELECTION_HOLD_TIME;
-            if (progress > 1.0) progress = 1.0;
+            progress = fixed_clamp(q16_16::ratio(elapsed, SELECTION_HOLD_TIME), q16_16(0), q16_16(1));
         }
-        uint8_t brightness = (uint8_t)(100 + 155 * progress);
+        uint8_t brightness = 100 + progress.scale(155);
         draw_rect(x, y, 8, 8, brightness, brightness, brightness, false);
     }
 
@@ -470,167 +524,167 @@ void draw_menu(void) {
     show_display();
 }
 
+// Transition backdrops, computed at compile time
+static constexpr auto RADIAL_FIELD = transition_radial<MATRIX_WIDTH, MATRIX_HEIGHT>();
+static constexpr auto WIPE_FIELD = transition_wipe<MATRIX_WIDTH, MATRIX_HEIGHT>();
+static constexpr auto SPIRAL_FIELD = transition_spiral<MATRIX_WIDTH, MATRIX_HEIGHT, 2>();
+#define RING_WIDTH 24   // 1.5 pixels, in radial field units
+static constexpr q16_16 TRANSITION_FADE(0.3);   // Share of the transition spent fading in, and out
+
 // Transition screen with animated text
-void show_transition_screen(const char* text, uint8_t r, uint8_t g, uint8_t b, int duration_ms) {
+void show_transition_screen(const char* text, uint8_t r, uint8_t g, uint8_t b, transition_t effect,
+                            int duration_ms) {
     int frames = duration_ms / 50;  // 50ms per frame
+    int length = strlen(text);
+    bool scroll = text_width(text) > MATRIX_WIDTH;
+    ws2812_pixel_t backdrop = {(uint8_t)(r / 4), (uint8_t)(g / 4), (uint8_t)(b / 4)};
 
     for (int frame = 0; frame < frames; frame++) {
         clear_display();
 
         // Calculate fade effect
-        float progress = (float)frame / frames;
-        float brightness = 1.0;
+        q16_16 progress = q16_16::ratio(frame, frames);
+        q16_16 brightness = 1;
 
         // Fade in for first 30%, full brightness for middle 40%, fade out for last 30%
-        if (progress < 0.3) {
-            brightness = progress / 0.3;
-        } else if (progress > 0.7) {
-            brightness = (1.0 - progress) / 0.3;
+        if (progress < TRANSITION_FADE) {
+            brightness = progress / TRANSITION_FADE;
+        } else if (progress > q16_16(1) - TRANSITION_FADE) {
+            brightness = (q16_16(1) - progress) / TRANSITION_FADE;
         }
 
-        // Simple text display - show game name with animation
-        if (strcmp(text, "PONG") == 0) {
-            // Draw P-O-N-G letters
-            int spacing = 3;
-            int start_x = 2;
+        // The LED driver applies the fade while encoding, so the scene is
+        // drawn at full colour instead of being rescaled every step
+        ws2812_set_fade(strip, brightness.scale(255));
 
-            // Animate letters appearing one by one
-            int visible_letters = (frame * 4) / (frames / 2);
-            if (visible_letters > 4) visible_letters = 4;
-
-            for (int i = 0; i < visible_letters; i++) {
-                int x = start_x + i * spacing;
-                uint8_t br = r * brightness;
-                uint8_t bg = g * brightness;
-                uint8_t bb = b * brightness;
-
-                // Draw simple 2x3 letters
-                switch(text[i]) {
-                    case 'P':
-                        set_pixel(x, 6, br, bg, bb);
-                        set_pixel(x, 7, br, bg, bb);
-                        set_pixel(x, 8, br, bg, bb);
-                        set_pixel(x+1, 6, br, bg, bb);
-                        set_pixel(x+1, 7, br, bg, bb);
-                        break;
-                    case 'O':
-                        set_pixel(x, 6, br, bg, bb);
-                        set_pixel(x, 7, br, bg, bb);
-                        set_pixel(x, 8, br, bg, bb);
-                        set_pixel(x+1, 6, br, bg, bb);
-                        set_pixel(x+1, 8, br, bg, bb);
-                        break;
-                    case 'N':
-                        set_pixel(x, 6, br, bg, bb);
-                        set_pixel(x, 7, br, bg, bb);
-                        set_pixel(x, 8, br, bg, bb);
-                        set_pixel(x+1, 6, br, bg, bb);
-                        set_pixel(x+1, 8, br, bg, bb);
-                        break;
-                    case 'G':
-                        set_pixel(x, 6, br, bg, bb);
-                        set_pixel(x, 7, br, bg, bb);
-                        set_pixel(x, 8, br, bg, bb);
-                        set_pixel(x+1, 6, br, bg, bb);
-                        set_pixel(x+1, 8, br, bg, bb);
-                        break;
-                }
-            }
+        // Dim backdrop behind the title
+        switch (effect) {
+            case TRANSITION_RING:
+                draw_transition(fb, RADIAL_FIELD,
+                                transition_level(RADIAL_FIELD, RING_WIDTH, frame, frames),
+                                RING_WIDTH, backdrop);
+                break;
+            case TRANSITION_IRIS:
+                draw_transition(fb, RADIAL_FIELD, transition_level(RADIAL_FIELD, 256, frame, frames),
+                                256, backdrop);
+                break;
+            case TRANSITION_WIPE:
+                draw_transition(fb, WIPE_FIELD, transition_level(WIPE_FIELD, 256, frame, frames),
+                                256, backdrop);
+                break;
+            case TRANSITION_SPIRAL:
+                draw_transition(fb, SPIRAL_FIELD, transition_level(SPIRAL_FIELD, 256, frame, frames),
+                                256, backdrop);
+                break;
+        }
+
+        if (scroll) {
+            // Too wide for the matrix: scroll across once over the transition
+            draw_marquee(fb, 5, text, frame * marquee_span(text, MATRIX_WIDTH) / frames, {r, g, b});
         } else {
-            // Generic transition - expanding circle
-            float radius = 8.0 * progress;
-            for (int y = 0; y < 16; y++) {
-                for (int x = 0; x < 16; x++) {
-                    float dist = sqrt((x - 7.5) * (x - 7.5) + (y - 7.5) * (y - 7.5));
-                    if (dist <= radius && dist >= radius - 1.5) {
-                        set_pixel(x, y, r * brightness, g * brightness, b * brightness);
-                    }
-                }
-            }
+            // Animate letters appearing one by one
+            int visible_letters = (frame * length) / (frames / 2);
+            draw_text(fb, (MATRIX_WIDTH - text_width(text)) / 2, 5, text, {r, g, b}, visible_letters);
         }
 
         show_display();
         vTaskDelay(50 / portTICK_PERIOD_MS);
     }
 
+    ws2812_set_fade(strip, 255);
     clear_display();
     show_display();
 }
 
 // Game over screen with score display
 void show_game_over_screen(int score, int high_score) {
-    // Animate "GAME OVER" text with score
+    // Animate "GAME OVER" text with score. The flash and the final fade are
+    // applied by the LED driver; the scene is only redrawn when it changes.
+    int drawn_scene = -1;
     for (int frame = 0; frame < 40; frame++) {  // 2 seconds at 50ms per frame
-        clear_display();
-
-        // Flash effect
-        float brightness = (frame % 10 < 5) ? 1.0 : 0.5;
-
-        // Draw "GAME" on top
-        draw_rect(3, 2, 10, 3, 255 * brightness, 0, 0, false);
-
-        // Draw "OVER" below
-        draw_rect(3, 6, 10, 3, 255 * brightness, 0, 0, false);
-
-        // Show score at bottom (simple number display)
-        if (score >= 0 && frame > 10) {
-            // Draw score indicator
-            for (int i = 0; i < score && i < 16; i++) {
-                set_pixel(i, 14, 0, 255, 0);  // Green dots for score
-            }
-
-            // Flash high score indicator if new high score
-            if (score > high_score && (frame % 6 < 3)) {
-                draw_rect(0, 12, 16, 1, 255, 255, 0, true);  // Yellow line for new high score
+        bool show_score = score >= 0 && frame > 10;
+        bool show_high = show_score && score > high_score && (frame % 6 < 3);
+        int scene = show_score | (show_high << 1);
+
+        if (scene != drawn_scene) {
+            clear_display();
+            draw_text_centered(fb, 0, "GAME", {255, 0, 0});
+            draw_text_centered(fb, 6, "OVER", {255, 0, 0});
+
+            // Show score at bottom, flashing yellow for a new high score
+            if (show_score) {
+                ws2812_pixel_t colour = show_high ? ws2812_pixel_t{255, 255, 0} : ws2812_pixel_t{0, 255, 0};
+                draw_number_centered(fb, 11, score, colour);
             }
+            drawn_scene = scene;
         }
 
+        // Flash effect
+        ws2812_set_fade(strip, (frame % 10 < 5) ? 255 : 128);
+
         show_display();
         vTaskDelay(50 / portTICK_PERIOD_MS);
     }
 
     // Final fade out
+    clear_display();
+    draw_text_centered(fb, 0, "GAME", {255, 0, 0});
+    draw_text_centered(fb, 6, "OVER", {255, 0, 0});
     for (int brightness = 255; brightness >= 0; brightness -= 15) {
-        clear_display();
-        float b = brightness / 255.0;
-        draw_rect(3, 2, 10, 3, 255 * b, 0, 0, false);
-        draw_rect(3, 6, 10, 3, 255 * b, 0, 0, false);
+        ws2812_set_fade(strip, brightness);
         show_display();
         vTaskDelay(30 / portTICK_PERIOD_MS);
     }
 
+    ws2812_set_fade(strip, 255);
     clear_display();
     show_display();
 }
 
 // Pong game implementation
 typedef struct {
-    float ball_x, ball_y;
-    float ball_vx, ball_vy;
+    q8_8 ball_x, ball_y;
+    q8_8 ball_vx, ball_vy;
+    q8_8 prev_ball_x, prev_ball_y;  // Ball before the last tick, for interpolation
     int player_y;
     int ai_y;
     int player_score;
     int ai_score;
+    int hud_player_score;   // Scores last drawn on the HUD layer
+    int hud_ai_score;
     bool game_over;
 } pong_state_t;
 
 static pong_state_t pong;
 
+static constexpr q8_8 PONG_SERVE_VY(0.5);
+static constexpr q8_8 PONG_SPIN(0.2);    // Vertical speed per row off the paddle centre
+
 void init_pong(void) {
     pong.ball_x = 8;
     pong.ball_y = 8;
     pong.ball_vx = 1;
-    pong.ball_vy = 0.5;
+    pong.ball_vy = PONG_SERVE_VY;
+    pong.prev_ball_x = pong.ball_x;
+    pong.prev_ball_y = pong.ball_y;
     pong.player_y = 7;
     pong.ai_y = 7;
     pong.player_score = 0;
     pong.ai_score = 0;
+    pong.hud_player_score = -1;
+    pong.hud_ai_score = -1;
     pong.game_over = false;
+
+    // Draw center line once; it never changes during a game
+    screen.reset();
+    for (int i = 0; i < 16; i += 2) {
+        screen.layer(LAYER_BACKGROUND).put(8, i, {40, 40, 40});
+    }
 }
 
-void update_pong(void) {
+void update_pong(int sensor_pos) {
     // Update player paddle
-    pong.player_y = get_sensor_position();
+    pong.player_y = sensor_pos;
     if (pong.player_y < 1) pong.player_y = 1;
     if (pong.player_y > 13) pong.player_y = 13;
 
@@ -644,6 +698,8 @@ void update_pong(void) {
     }
 
     // Update ball
+    pong.prev_ball_x = pong.ball_x;
+    pong.prev_ball_y = pong.ball_y;
     pong.ball_x += pong.ball_vx;
     pong.ball_y += pong.ball_vy;
 
@@ -656,26 +712,30 @@ void update_pong(void) {
     if (pong.ball_x <= 1) {
         if (pong.ball_y >= pong.player_y - 1 && pong.ball_y <= pong.player_y + 2) {
             pong.ball_vx = -pong.ball_vx;
-            pong.ball_vy += (pong.ball_y - (pong.player_y + 1)) * 0.2;
+            pong.ball_vy += (pong.ball_y - (pong.player_y + 1)) * PONG_SPIN;
         } else {
             pong.ai_score++;
             pong.ball_x = 8;
             pong.ball_y = 8;
             pong.ball_vx = 1;
-            pong.ball_vy = 0.5;
+            pong.ball_vy = PONG_SERVE_VY;
+            pong.prev_ball_x = pong.ball_x;
+            pong.prev_ball_y = pong.ball_y;
         }
     }
 
     if (pong.ball_x >= 14) {
         if (pong.ball_y >= pong.ai_y - 1 && pong.ball_y <= pong.ai_y + 2) {
             pong.ball_vx = -pong.ball_vx;
-            pong.ball_vy += (pong.ball_y - (pong.ai_y + 1)) * 0.2;
+            pong.ball_vy += (pong.ball_y - (pong.ai_y + 1)) * PONG_SPIN;
         } else {
             pong.player_score++;
             pong.ball_x = 8;
             pong.ball_y = 8;
             pong.ball_vx = -1;
-            pong.ball_vy = 0.5;
+            pong.ball_vy = PONG_SERVE_VY;
+            pong.prev_ball_x = pong.ball_x;
+            pong.prev_ball_y = pong.ball_y;
         }
     }
 
@@ -684,33 +744,42 @@ void update_pong(void) {
     }
 }
 
-void render_pong(void) {
-    clear_display();
-
+// alpha is how far the next tick has come, 0 to 1; the ball is drawn that
+// far from where the last tick found it to where it is now. Both ends are
+// between the paddles, so it never lands in a paddle column.
+void render_pong(q8_8 alpha) {
     // Draw paddles
-    draw_rect(0, pong.player_y, 1, 3, 0, 0, 255, true);  // Blue player paddle
-    draw_rect(15, pong.ai_y, 1, 3, 255, 0, 0, true);    // Red AI paddle
+    auto &playfield = screen.layer(LAYER_PLAYFIELD);
+    playfield.clear();
+    playfield.fill_rect(0, pong.player_y, 1, 3, {0, 0, 255});  // Blue player paddle
+    playfield.fill_rect(15, pong.ai_y, 1, 3, {255, 0, 0});    // Red AI paddle
 
     // Draw ball
-    set_pixel((int)pong.ball_x, (int)pong.ball_y, 255, 255, 255);
-
-    // Draw center line
-    for (int i = 0; i < 16; i += 2) {
-        set_pixel(8, i, 40, 40, 40);
-    }
+    auto &sprites = screen.layer(LAYER_SPRITES);
+    sprites.clear();
+    q8_8 ball_x = fixed_lerp(pong.prev_ball_x, pong.ball_x, alpha);
+    q8_8 ball_y = fixed_clamp<q8_8>(fixed_lerp(pong.prev_ball_y, pong.ball_y, alpha), 0, 15);
+    sprites.set(ball_x.to_int(), ball_y.to_int(), {255, 255, 255});
 
     // Display scores as dots at the top
-    for (int i = 0; i < pong.player_score && i < 5; i++) {
-        set_pixel(3 + i, 0, 0, 0, 255);
-    }
-    for (int i = 0; i < pong.ai_score && i < 5; i++) {
-        set_pixel(12 - i, 0, 255, 0, 0);
+    if (pong.player_score != pong.hud_player_score || pong.ai_score != pong.hud_ai_score) {
+        auto &hud = screen.layer(LAYER_HUD);
+        hud.clear();
+        for (int i = 0; i < pong.player_score && i < 5; i++) {
+            hud.put(3 + i, 0, {0, 0, 255});
+        }
+        for (int i = 0; i < pong.ai_score && i < 5; i++) {
+            hud.put(12 - i, 0, {255, 0, 0});
+        }
+        pong.hud_player_score = pong.player_score;
+        pong.hud_ai_score = pong.ai_score;
     }
 
+    screen.compose();
     show_display();
 }
 
-void run_pong(void) {
+void run_pong(int sensor_pos) {
     static bool initialized = false;
     static int high_score = 0;
     if (!initialized) {
@@ -719,8 +788,7 @@ void run_pong(void) {
         initialized = true;
     }
 
-    update_pong();
-    render_pong();
+    update_pong(sensor_pos);
 
     if (pong.game_over) {
         // Determine winner and score
@@ -735,12 +803,20 @@ void run_pong(void) {
 }
 
 // Flappy Bird implementation
-void run_flappy(void) {
-    static float bird_y = 8;
-    static float bird_vy = 0;
-    static int pipe_x = 16;
-    static int pipe_gap_y = 8;
-    static bool game_over = false;
+static constexpr q8_8 FLAPPY_FLAP_VY(-1.5);
+static constexpr q8_8 FLAPPY_GRAVITY(0.15);
+
+typedef struct {
+    q8_8 bird_y;
+    q8_8 bird_vy;
+    int pipe_x;
+    int pipe_gap_y;
+    bool game_over;
+} flappy_state_t;
+
+static flappy_state_t flappy = {8, 0, 16, 8, false};
+
+void run_flappy(int sensor_pos) {
     static bool initialized = false;
 
     if (!initialized) {
@@ -748,145 +824,176 @@ void run_flappy(void) {
         initialized = true;
     }
 
-    if (game_over) {
+    if (flappy.game_over) {
         static int score = 0;
         static int high_score = 0;
         if (score > high_score) high_score = score;
         show_game_over_screen(score, high_score);
         current_mode = MENU;
-        bird_y = 8;
-        bird_vy = 0;
-        pipe_x = 16;
-        game_over = false;
+        flappy.bird_y = 8;
+        flappy.bird_vy = 0;
+        flappy.pipe_x = 16;
+        flappy.game_over = false;
         score = 0;
         initialized = false;
         return;
     }
 
     // Update bird based on sensor
-    int sensor_pos = get_sensor_position();
     if (sensor_pos < 5) {
-        bird_vy = -1.5;
+        flappy.bird_vy = FLAPPY_FLAP_VY;
     }
-    bird_vy += 0.15;
-    bird_y += bird_vy;
+    flappy.bird_vy += FLAPPY_GRAVITY;
+    flappy.bird_y += flappy.bird_vy;
 
-    if (bird_y < 0) bird_y = 0;
-    if (bird_y > 15) {
-        game_over = true;
+    if (flappy.bird_y < 0) flappy.bird_y = 0;
+    if (flappy.bird_y > 15) {
+        flappy.game_over = true;
         return;
     }
 
     // Update pipe
-    pipe_x--;
-    if (pipe_x < -1) {
-        pipe_x = 16;
-        pipe_gap_y = rand() % 8 + 3;
+    flappy.pipe_x--;
+    if (flappy.pipe_x < -1) {
+        flappy.pipe_x = 16;
+        flappy.pipe_gap_y = rand() % 8 + 3;
     }
 
     // Check collision
-    if (pipe_x == 4) {
-        if (bird_y < pipe_gap_y || bird_y > pipe_gap_y + 3) {
-            game_over = true;
+    if (flappy.pipe_x == 4) {
+        if (flappy.bird_y < flappy.pipe_gap_y || flappy.bird_y > flappy.pipe_gap_y + 3) {
+            flappy.game_over = true;
             return;
         }
     }
+}
 
-    // Render
+void render_flappy(q8_8 alpha) {
     clear_display();
-    set_pixel(4, (int)bird_y, 255, 255, 0);  // Yellow bird
+    q8_8 bird_y = fixed_clamp<q8_8>(flappy.bird_y + flappy.bird_vy * alpha, 0, 15);
+    set_pixel(4, bird_y.to_int(), 255, 255, 0);  // Yellow bird
 
-    if (pipe_x >= 0 && pipe_x < 16) {
-        for (int y = 0; y < 16; y++) {
-            if (y < pipe_gap_y || y > pipe_gap_y + 3) {
-                set_pixel(pipe_x, y, 0, 255, 0);  // Green pipes
-            }
-        }
-    }
+    // Green pipes above and below the gap; off-screen columns clip away
+    fb.vline(flappy.pipe_x, 0, flappy.pipe_gap_y, {0, 255, 0});
+    fb.vline(flappy.pipe_x, flappy.pipe_gap_y + 4, 16 - (flappy.pipe_gap_y + 4), {0, 255, 0});
 
     show_display();
 }
 
 // Catch game implementation
-void run_catch(void) {
-    static int basket_x = 7;
-    static float item_y = 0;
-    static int item_x = 8;
-    static bool item_is_good = true;
-    static int lives = 3;
+static constexpr q8_8 CATCH_FALL_SPEED(0.3);
+
+typedef struct {
+    int basket_x;
+    q8_8 item_y;
+    int item_x;
+    bool item_is_good;
+    int lives;
+    int hud_lives;          // Lives last drawn on the HUD layer
+} catch_state_t;
+
+static catch_state_t catch_game = {7, 0, 8, true, 3, -1};
+
+void run_catch(int sensor_pos) {
     static int score = 0;
     static bool initialized = false;
     static int high_score = 0;
 
     if (!initialized) {
         print_game_legend(CATCH);
+        screen.reset();
+        catch_game.hud_lives = -1;
         initialized = true;
     }
 
-    if (lives <= 0) {
+    if (catch_game.lives <= 0) {
         if (score > high_score) high_score = score;
         show_game_over_screen(score, high_score);
         current_mode = MENU;
-        lives = 3;
+        catch_game.lives = 3;
         score = 0;
         initialized = false;
         return;
     }
 
     // Update basket
-    basket_x = get_sensor_position();
-    if (basket_x > 13) basket_x = 13;
+    catch_game.basket_x = sensor_pos;
+    if (catch_game.basket_x > 13) catch_game.basket_x = 13;
 
     // Update falling item
-    item_y += 0.3;
-    if (item_y >= 14) {
-        if (item_x >= basket_x && item_x < basket_x + 3) {
+    catch_game.item_y += CATCH_FALL_SPEED;
+    if (catch_game.item_y >= 14) {
+        if (catch_game.item_x >= catch_game.basket_x && catch_game.item_x < catch_game.basket_x + 3) {
             // Caught!
-            if (item_is_good) {
+            if (catch_game.item_is_good) {
                 score++;
             } else {
-                lives--;
+                catch_game.lives--;
             }
-        } else if (item_is_good) {
-            lives--;
+        } else if (catch_game.item_is_good) {
+            catch_game.lives--;
         }
-        item_y = 0;
-        item_x = rand() % 16;
-        item_is_good = (rand() % 3) != 0;  // 2/3 chance of good item
+        catch_game.item_y = 0;
+        catch_game.item_x = rand() % 16;
+        catch_game.item_is_good = (rand() % 3) != 0;  // 2/3 chance of good item
     }
+}
 
-    // Render
-    clear_display();
-    draw_rect(basket_x, 14, 3, 2, 0, 0, 255, true);  // Blue basket
-
-    if (item_is_good) {
-        set_pixel(item_x, (int)item_y, 0, 255, 128);  // Teal for good items
+void render_catch(q8_8 alpha) {
+    auto &playfield = screen.layer(LAYER_PLAYFIELD);
+    playfield.clear();
+    playfield.fill_rect(catch_game.basket_x, 14, 3, 2, {0, 0, 255});  // Blue basket
+
+    auto &sprites = screen.layer(LAYER_SPRITES);
+    sprites.clear();
+    // Falling on from the last tick, but never into the basket's rows: the
+    // next tick decides whether it was caught
+    int item_y = fixed_clamp<q8_8>(catch_game.item_y + CATCH_FALL_SPEED * alpha, 0, 13).to_int();
+    if (catch_game.item_is_good) {
+        sprites.set(catch_game.item_x, item_y, {0, 255, 128});  // Teal for good items
     } else {
-        set_pixel(item_x, (int)item_y, 255, 0, 0);    // Red for bad items
+        sprites.set(catch_game.item_x, item_y, {255, 0, 0});    // Red for bad items
     }
 
     // Draw lives
-    for (int i = 0; i < lives && i < 3; i++) {
-        set_pixel(i, 0, 255, 0, 0);
+    if (catch_game.lives != catch_game.hud_lives) {
+        auto &hud = screen.layer(LAYER_HUD);
+        hud.clear();
+        for (int i = 0; i < catch_game.lives && i < 3; i++) {
+            hud.put(i, 0, {255, 0, 0});
+        }
+        catch_game.hud_lives = catch_game.lives;
     }
 
+    screen.compose();
     show_display();
 }
 
 // Space Invaders implementation
-void run_invaders(void) {
-    static int player_x = 7;
-    static int invaders[20];
-    static int bullet_x = -1;
-    static int bullet_y = -1;
-    static int invader_y = 0;
+static const uint16_t INVADER_ROWS[] = {0xC000};
+static const uint16_t CANNON_ROWS[] = {0xC000, 0xC000};
+static const Sprite INVADER = {2, 1, INVADER_ROWS};
+static const Sprite CANNON = {2, 2, CANNON_ROWS};
+
+typedef struct {
+    int player_x;
+    int invaders[20];
+    int bullet_x;
+    int bullet_y;
+    int invader_y;
+} invaders_state_t;
+
+static invaders_state_t invaders_game = {7, {0}, -1, -1, 0};
+
+void run_invaders(int sensor_pos) {
     static bool initialized = false;
     static int score = 0;
     static int high_score = 0;
+    invaders_state_t &game = invaders_game;
 
     if (!initialized) {
         for (int i = 0; i < 20; i++) {
-            invaders[i] = 1;
+            game.invaders[i] = 1;
         }
         score = 0;
         print_game_legend(INVADERS);
@@ -894,29 +1001,29 @@ void run_invaders(void) {
     }
 
     // Update player
-    player_x = get_sensor_position();
-    if (player_x > 14) player_x = 14;
+    game.player_x = sensor_pos;
+    if (game.player_x > 14) game.player_x = 14;
 
     // Fire bullet (simplified - fires when player moves quickly)
     static int last_player_x = 7;
-    if (bullet_y < 0 && abs(player_x - last_player_x) > 3) {
-        bullet_x = player_x + 1;
-        bullet_y = 13;
+    if (game.bullet_y < 0 && abs(game.player_x - last_player_x) > 3) {
+        game.bullet_x = game.player_x + 1;
+        game.bullet_y = 13;
     }
-    last_player_x = player_x;
+    last_player_x = game.player_x;
 
     // Update bullet
-    if (bullet_y >= 0) {
-        bullet_y--;
+    if (game.bullet_y >= 0) {
+        game.bullet_y--;
         // Check collision with invaders
         for (int i = 0; i < 20; i++) {
-            if (invaders[i]) {
+            if (game.invaders[i]) {
                 int inv_x = (i % 5) * 3 + 1;
-                int inv_y = (i / 5) * 2 + 1 + invader_y;
-                if (bullet_x >= inv_x && bullet_x < inv_x + 2 &&
-                    bullet_y >= inv_y && bullet_y < inv_y + 2) {
-                    invaders[i] = 0;
-                    bullet_y = -1;
+                int inv_y = (i / 5) * 2 + 1 + game.invader_y;
+                if (game.bullet_x >= inv_x && game.bullet_x < inv_x + 2 &&
+                    game.bullet_y >= inv_y && game.bullet_y < inv_y + 2) {
+                    game.invaders[i] = 0;
+                    game.bullet_y = -1;
                     score++;  // Increment score for each invader destroyed
                     break;
                 }
@@ -927,7 +1034,7 @@ void run_invaders(void) {
     // Check if all invaders destroyed
     bool any_alive = false;
     for (int i = 0; i < 20; i++) {
-        if (invaders[i]) {
+        if (game.invaders[i]) {
             any_alive = true;
             break;
         }
@@ -940,23 +1047,26 @@ void run_invaders(void) {
         initialized = false;
         return;
     }
+}
+
+void render_invaders(void) {
+    const invaders_state_t &game = invaders_game;
 
-    // Render
     clear_display();
-    draw_rect(player_x, 14, 2, 2, 0, 255, 255, true);  // Cyan player
+    blit(fb, CANNON, game.player_x, 14, {0, 255, 255});  // Cyan player
 
     // Draw bullet
-    if (bullet_y >= 0) {
-        set_pixel(bullet_x, bullet_y, 255, 255, 0);  // Yellow bullet
+    if (game.bullet_y >= 0) {
+        set_pixel(game.bullet_x, game.bullet_y, 255, 255, 0);  // Yellow bullet
     }
 
     // Draw invaders
     for (int i = 0; i < 20; i++) {
-        if (invaders[i]) {
+        if (game.invaders[i]) {
             int x = (i % 5) * 3 + 1;
-            int y = (i / 5) * 2 + 1 + invader_y;
+            int y = (i / 5) * 2 + 1 + game.invader_y;
             if (y < 14) {
-                draw_rect(x, y, 2, 1, 0, 255, 0, true);  // Green invaders
+                blit(fb, INVADER, x, y, {0, 255, 0});  // Green invaders
             }
         }
     }
@@ -964,18 +1074,67 @@ void run_invaders(void) {
     show_display();
 }
 
+// Advance game by one GAME_TICK_MS step with the frame's sensor position
+static void tick_game(game_mode_t game, int sensor_pos) {
+    switch (game) {
+        case PONG:     run_pong(sensor_pos);     break;
+        case FLAPPY:   run_flappy(sensor_pos);   break;
+        case CATCH:    run_catch(sensor_pos);    break;
+        case INVADERS: run_invaders(sensor_pos); break;
+        default: break;
+    }
+}
+
+// Draw game's current state, alpha of the way to the next tick, and send it
+// to the matrix. Invaders moves in whole pixels per tick, so it has nothing
+// to interpolate.
+static void render_game(game_mode_t game, q8_8 alpha) {
+    switch (game) {
+        case PONG:     render_pong(alpha);   break;
+        case FLAPPY:   render_flappy(alpha); break;
+        case CATCH:    render_catch(alpha);  break;
+        case INVADERS: render_invaders();    break;
+        default: break;
+    }
+}
+
 void game_task(void *pvParameters) {
     ESP_LOGI(TAG, "Game task started");
 
     static game_mode_t last_mode = (game_mode_t)-1;
+    uint32_t last_stats_time = esp_timer_get_time() / 1000;
+    uint32_t last_frame_time = last_stats_time;
+    uint32_t tick_accumulator = 0;  // Elapsed time not yet simulated (ms)
+    TickType_t frame_wake = xTaskGetTickCount();
 
     while (1) {
+        // Frame start, before the sensor read so game time includes it. The
+        // sensor is read once per frame; every tick in the frame uses it.
+        uint32_t now = esp_timer_get_time() / 1000;
         sensor_distance = read_tof_sensor();
+        int sensor_pos = get_sensor_position(sensor_distance);
+
+        tick_accumulator += now - last_frame_time;
+        if (tick_accumulator > MAX_TICKS_PER_FRAME * GAME_TICK_MS) {
+            tick_accumulator = MAX_TICKS_PER_FRAME * GAME_TICK_MS;
+        }
+        last_frame_time = now;
+
+        // Periodic LED driver timing report
+        if (led_stats_mode && now - last_stats_time >= LED_STATS_INTERVAL_MS) {
+            ws2812_log_stats(strip);
+            ws2812_reset_stats(strip);
+            last_stats_time = now;
+        }
 
         // Print legend when mode changes
         if (current_mode != last_mode) {
             print_game_legend(current_mode);
             last_mode = current_mode;
+            // Time spent in the menu or on a transition screen is not game
+            // time; start with one tick so the game initialises before it
+            // is first drawn
+            tick_accumulator = GAME_TICK_MS;
         }
 
         switch (current_mode) {
@@ -983,7 +1142,7 @@ void game_task(void *pvParameters) {
                 // Check if hand is in valid range
                 if (sensor_distance >= MIN_SELECTION_DISTANCE && sensor_distance <= MAX_SELECTION_DISTANCE) {
                     // Calculate selection based on position
-                    int new_selection = get_sensor_position() / 4;
+                    int new_selection = sensor_pos / 4;
                     if (new_selection > 3) new_selection = 3;
 
                     // Check if selection changed
@@ -1007,6 +1166,7 @@ void game_task(void *pvParameters) {
 
                             // Show transition screen based on selected game
                             const char* game_name = "";
+                            transition_t effect = TRANSITION_RING;
                             uint8_t r = 255, g = 255, b = 255;
 
                             switch (menu_selection) {
@@ -1018,22 +1178,25 @@ void game_task(void *pvParameters) {
                                 case 1:
                                     game_name = "FLAPPY";
                                     r = 255; g = 255; b = 0;  // Yellow
+                                    effect = TRANSITION_WIPE;
                                     current_mode = FLAPPY;
                                     break;
                                 case 2:
                                     game_name = "CATCH";
                                     r = 0; g = 255; b = 0;  // Green
+                                    effect = TRANSITION_IRIS;
                                     current_mode = CATCH;
                                     break;
                                 case 3:
                                     game_name = "INVADERS";
                                     r = 0; g = 255; b = 255;  // Cyan
+                                    effect = TRANSITION_SPIRAL;
                                     current_mode = INVADERS;
                                     break;
                             }
 
                             // Show transition animation
-                            show_transition_screen(game_name, r, g, b, 1500);
+                            show_transition_screen(game_name, r, g, b, effect, 1500);
 
                             ESP_LOGI(TAG, "Starting game: %d", current_mode);
 
@@ -1041,7 +1204,7 @@ void game_task(void *pvParameters) {
                             menu_selection = -1;
                             last_stable_selection = -1;
                             selection_start_time = 0;
-                        } else if (elapsed % 1000 < 50) {  // Log progress every second
+                        } else if (elapsed % 1000 < FRAME_MS) {  // Log progress every second
                             if (tof_debug_mode) {
                                 ESP_LOGI(TAG, "Hold progress: %.1f seconds", elapsed / 1000.0);
                             }
@@ -1063,24 +1226,30 @@ void game_task(void *pvParameters) {
                 break;
             }
 
-            case PONG:
-                run_pong();
-                break;
-
-            case FLAPPY:
-                run_flappy();
-                break;
-
-            case CATCH:
-                run_catch();
-                break;
-
-            case INVADERS:
-                run_invaders();
+            default: {
+                // Run every tick that is due, then draw once with motion
+                // interpolated by the time left over. A tick can end the game
+                // and return to the menu, which stops both. Frames that come
+                // out the same as the last are not resent by the driver.
+                game_mode_t game = current_mode;
+                while (tick_accumulator >= GAME_TICK_MS && current_mode == game) {
+                    tick_game(game, sensor_pos);
+                    tick_accumulator -= GAME_TICK_MS;
+                }
+                if (current_mode == game) {
+                    render_game(game, q8_8::ratio(tick_accumulator, GAME_TICK_MS));
+                }
                 break;
+            }
         }
 
-        vTaskDelay(50 / portTICK_PERIOD_MS);  // 20 FPS
+        // Sleep until the next frame boundary. A frame that overran does not
+        // block, so yield a tick anyway and restart the schedule from now
+        // rather than rushing through the frames it missed.
+        if (!xTaskDelayUntil(&frame_wake, FRAME_TICKS)) {
+            vTaskDelay(1);
+            frame_wake = xTaskGetTickCount();
+        }
     }
 }
 
@@ -0,0 +1,98 @@
+#include <unity.h>
+#include <stdio.h>
+#include "WS2812.h"
+
+// Per-pixel cost of rainbow fills: ws2812_hsv_to_rgb() or ws2812_wheel()
+// plus ws2812_set_pixel() for every pixel, against the span fills
+
+#define PIXELS 256
+#define FRAMES 200
+
+static ws2812_t *strip;
+static uint8_t frame_hue;
+
+void setUp(void) {
+    strip = ws2812_alloc(PIXELS, 1);
+    frame_hue = 0;
+}
+
+void tearDown(void) {
+    ws2812_free(strip);
+    strip = NULL;
+}
+
+static void fill_hsv_per_pixel(void) {
+    for (int i = 0; i < PIXELS; i++) {
+        ws2812_pixel_t c = ws2812_hsv_to_rgb(frame_hue + i, 255, 255);
+        ws2812_set_pixel(strip, i, c.r, c.g, c.b);
+    }
+    frame_hue++;
+}
+
+static void fill_hsv_span(void) {
+    ws2812_fill_hsv_gradient(strip, 0, PIXELS, frame_hue++, 256, 255, 255);
+}
+
+static void fill_wheel_per_pixel(void) {
+    for (int i = 0; i < PIXELS; i++) {
+        ws2812_set_pixel_rgb(strip, i, ws2812_wheel(frame_hue + i));
+    }
+    frame_hue++;
+}
+
+static void fill_wheel_span(void) {
+    ws2812_fill_wheel(strip, 0, PIXELS, frame_hue++, 256);
+}
+
+static uint32_t cycles_per_pixel(void (*fill)(void)) {
+    fill();
+    uint32_t start = esp_cpu_get_cycle_count();
+    for (int f = 0; f < FRAMES; f++) {
+        fill();
+    }
+    return (esp_cpu_get_cycle_count() - start) / (FRAMES * PIXELS);
+}
+
+static void report(const char *name, uint32_t cycles) {
+    char line[64];
+    snprintf(line, sizeof(line), "%-16s %4u cycles/pixel", name, (unsigned)cycles);
+    TEST_MESSAGE(line);
+}
+
+static void test_bench_hsv_per_pixel_vs_span(void) {
+    report("hsv per pixel", cycles_per_pixel(fill_hsv_per_pixel));
+    report("hsv span", cycles_per_pixel(fill_hsv_span));
+
+    // The span reads a hue table, so it may round differently by one
+    ws2812_fill_hsv_gradient(strip, 0, PIXELS, 0, 256, 255, 255);
+    for (int i = 0; i < PIXELS; i++) {
+        ws2812_pixel_t expected = ws2812_hsv_to_rgb(i, 255, 255);
+        ws2812_pixel_t pixel = ws2812_get_pixel(strip, i);
+        TEST_ASSERT_INT_WITHIN(1, expected.r, pixel.r);
+        TEST_ASSERT_INT_WITHIN(1, expected.g, pixel.g);
+        TEST_ASSERT_INT_WITHIN(1, expected.b, pixel.b);
+    }
+}
+
+static void test_bench_wheel_per_pixel_vs_span(void) {
+    report("wheel per pixel", cycles_per_pixel(fill_wheel_per_pixel));
+    report("wheel span", cycles_per_pixel(fill_wheel_span));
+
+    ws2812_fill_wheel(strip, 0, PIXELS, 0, 256);
+    for (int i = 0; i < PIXELS; i++) {
+        ws2812_pixel_t expected = ws2812_wheel(i);
+        ws2812_pixel_t pixel = ws2812_get_pixel(strip, i);
+        TEST_ASSERT_EQUAL(expected.r, pixel.r);
+        TEST_ASSERT_EQUAL(expected.g, pixel.g);
+        TEST_ASSERT_EQUAL(expected.b, pixel.b);
+    }
+}
+
+int main(int argc, char **argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_bench_hsv_per_pixel_vs_span);
+    RUN_TEST(test_bench_wheel_per_pixel_vs_span);
+    return UNITY_END();
+}
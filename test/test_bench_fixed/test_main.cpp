@@ -0,0 +1,154 @@
+#include <unity.h>
+#include <stdio.h>
+#include "WS2812.h"
+#include "FixedPoint.h"
+
+// Cycles per game update: the Pong ball and Flappy bird steps as they were
+// written with float, against the q8_8 versions the games use now. The
+// ESP32-C3 has no FPU, so on target the float side runs in soft-float
+// routines; on a host with hardware floating point the gap is much smaller
+// or reversed.
+
+#define UPDATES 20000
+
+static constexpr q8_8 PONG_SERVE_VY(0.5);
+static constexpr q8_8 PONG_SPIN(0.2);
+static constexpr q8_8 FLAPPY_FLAP_VY(-1.5);
+static constexpr q8_8 FLAPPY_GRAVITY(0.15);
+
+template <typename N>
+struct game_state_t {
+    N ball_x, ball_y, ball_vx, ball_vy;
+    N bird_y, bird_vy;
+    int ai_y;
+};
+
+static game_state_t<float> float_state;
+static game_state_t<q8_8> fixed_state;
+
+void setUp(void) {
+    float_state = {8, 8, 1, 0.5f, 8, 0, 7};
+    fixed_state = {8, 8, 1, PONG_SERVE_VY, 8, 0, 7};
+}
+
+void tearDown(void) {
+}
+
+// Sensor readings that sweep the paddle and make the bird flap now and then
+static int sensor(int step) {
+    return (step * 7) % 16;
+}
+
+static void update_float(int step) {
+    game_state_t<float> &s = float_state;
+    int player_y = sensor(step);
+
+    if (s.ball_y < s.ai_y + 1) {
+        s.ai_y--;
+    } else if (s.ball_y > s.ai_y + 1) {
+        s.ai_y++;
+    }
+
+    s.ball_x += s.ball_vx;
+    s.ball_y += s.ball_vy;
+    if (s.ball_y <= 0 || s.ball_y >= 15) {
+        s.ball_vy = -s.ball_vy;
+    }
+    if (s.ball_x <= 1 || s.ball_x >= 14) {
+        int paddle_y = s.ball_x <= 1 ? player_y : s.ai_y;
+        if (s.ball_y >= paddle_y - 1 && s.ball_y <= paddle_y + 2) {
+            s.ball_vx = -s.ball_vx;
+            s.ball_vy += (s.ball_y - (paddle_y + 1)) * 0.2;
+        } else {
+            s.ball_x = 8;
+            s.ball_y = 8;
+            s.ball_vy = 0.5;
+        }
+    }
+
+    if (player_y < 5) {
+        s.bird_vy = -1.5;
+    }
+    s.bird_vy += 0.15;
+    s.bird_y += s.bird_vy;
+    if (s.bird_y < 0) s.bird_y = 0;
+    if (s.bird_y > 15) s.bird_y = 8;
+}
+
+static void update_fixed(int step) {
+    game_state_t<q8_8> &s = fixed_state;
+    int player_y = sensor(step);
+
+    if (s.ball_y < s.ai_y + 1) {
+        s.ai_y--;
+    } else if (s.ball_y > s.ai_y + 1) {
+        s.ai_y++;
+    }
+
+    s.ball_x += s.ball_vx;
+    s.ball_y += s.ball_vy;
+    if (s.ball_y <= 0 || s.ball_y >= 15) {
+        s.ball_vy = -s.ball_vy;
+    }
+    if (s.ball_x <= 1 || s.ball_x >= 14) {
+        int paddle_y = s.ball_x <= 1 ? player_y : s.ai_y;
+        if (s.ball_y >= paddle_y - 1 && s.ball_y <= paddle_y + 2) {
+            s.ball_vx = -s.ball_vx;
+            s.ball_vy += (s.ball_y - (paddle_y + 1)) * PONG_SPIN;
+        } else {
+            s.ball_x = 8;
+            s.ball_y = 8;
+            s.ball_vy = PONG_SERVE_VY;
+        }
+    }
+
+    if (player_y < 5) {
+        s.bird_vy = FLAPPY_FLAP_VY;
+    }
+    s.bird_vy += FLAPPY_GRAVITY;
+    s.bird_y += s.bird_vy;
+    if (s.bird_y < 0) s.bird_y = 0;
+    if (s.bird_y > 15) s.bird_y = 8;
+}
+
+static uint32_t cycles_per_update(void (*update)(int)) {
+    uint32_t start = esp_cpu_get_cycle_count();
+    for (int step = 0; step < UPDATES; step++) {
+        update(step);
+    }
+    return (esp_cpu_get_cycle_count() - start) / UPDATES;
+}
+
+static void report(const char *name, uint32_t cycles) {
+    char line[64];
+    snprintf(line, sizeof(line), "%-6s %4u cycles/update", name, (unsigned)cycles);
+    TEST_MESSAGE(line);
+}
+
+static void test_bench_float_vs_fixed_update(void) {
+    report("float", cycles_per_update(update_float));
+    report("q8_8", cycles_per_update(update_fixed));
+
+    // Saturating arithmetic and the bounces keep everything on the matrix
+    TEST_ASSERT_TRUE(fixed_state.ball_x >= 0 && fixed_state.ball_x <= 15);
+    TEST_ASSERT_TRUE(fixed_state.bird_y >= 0 && fixed_state.bird_y <= 15);
+}
+
+static void test_fixed_steps_track_float(void) {
+    // Over one rally the two stay within a pixel of each other
+    for (int step = 0; step < 12; step++) {
+        update_float(step);
+        update_fixed(step);
+        TEST_ASSERT_INT_WITHIN(1, (int)float_state.ball_y, fixed_state.ball_y.to_int());
+        TEST_ASSERT_INT_WITHIN(1, (int)float_state.bird_y, fixed_state.bird_y.to_int());
+    }
+}
+
+int main(int argc, char **argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_bench_float_vs_fixed_update);
+    RUN_TEST(test_fixed_steps_track_float);
+    return UNITY_END();
+}
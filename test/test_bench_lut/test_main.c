@@ -0,0 +1,95 @@
+#include <unity.h>
+#include <stdio.h>
+#include "WS2812.h"
+
+// Cycles to encode a 256-pixel frame into the wire buffer: three integer
+// divisions per pixel, as ws2812_show() did before the correction tables,
+// against the driver's table lookups (brightness, gamma and white balance
+// included). Both sides compare against the previous frame the same way and
+// time the encode step alone.
+
+#define PIXELS 256
+#define FRAMES 200
+
+static ws2812_t *strip;
+static uint8_t divided[PIXELS * 3];
+static volatile uint8_t brightness = 50;
+static volatile uint16_t send_pixels;
+
+void setUp(void) {
+    strip = ws2812_alloc(PIXELS, 1);
+    for (int i = 0; i < PIXELS; i++) {
+        ws2812_set_pixel(strip, i, i, 255 - i, i * 7);
+    }
+}
+
+void tearDown(void) {
+    ws2812_free(strip);
+    strip = NULL;
+}
+
+// ws2812_encode_rgb() with the scaling done by division
+static void encode_divide(void) {
+    uint8_t scale = brightness;
+    const ws2812_pixel_t *pixel = strip->pixels;
+    uint8_t *out = divided;
+    uint16_t changed = 0;
+    for (int i = 0; i < PIXELS; i++, pixel++) {
+        uint8_t g = (pixel->g * scale) / 255;
+        uint8_t r = (pixel->r * scale) / 255;
+        uint8_t b = (pixel->b * scale) / 255;
+        if ((out[0] ^ g) | (out[1] ^ r) | (out[2] ^ b)) {
+            changed = i + 1;
+        }
+        *out++ = g;
+        *out++ = r;
+        *out++ = b;
+    }
+    send_pixels = changed;
+}
+
+static void encode_lut(void) {
+    send_pixels = ws2812_encode_segment(strip, &strip->segments[0], PIXELS, 256);
+}
+
+static uint32_t cycles_per_frame(void (*encode)(void)) {
+    encode();
+    uint32_t start = esp_cpu_get_cycle_count();
+    for (int f = 0; f < FRAMES; f++) {
+        encode();
+    }
+    return (esp_cpu_get_cycle_count() - start) / FRAMES;
+}
+
+static void report(const char *name, uint32_t cycles) {
+    char line[96];
+    snprintf(line, sizeof(line), "%-9s %7u cycles/frame %5u cycles/pixel", name,
+             (unsigned)cycles, (unsigned)(cycles / PIXELS));
+    TEST_MESSAGE(line);
+}
+
+static void test_bench_encode_division_vs_lut(void) {
+    ws2812_set_brightness(strip, brightness);
+    ws2812_set_gamma(strip, 2.2f);
+
+    // Only the warm-up frame differs from what the wire buffer held
+    uint32_t divide = cycles_per_frame(encode_divide);
+    TEST_ASSERT_EQUAL(0, send_pixels);
+    uint32_t lut = cycles_per_frame(encode_lut);
+    TEST_ASSERT_EQUAL(0, send_pixels);
+    report("division", divide);
+    report("lut", lut);
+
+    // Pixel 1 is (1, 254, 7), through the tables in GRB order
+    TEST_ASSERT_EQUAL(strip->out_g[254], strip->wire[3]);
+    TEST_ASSERT_EQUAL(strip->out_r[1], strip->wire[4]);
+    TEST_ASSERT_EQUAL(strip->out_b[7], strip->wire[5]);
+}
+
+int main(int argc, char **argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_bench_encode_division_vs_lut);
+    return UNITY_END();
+}
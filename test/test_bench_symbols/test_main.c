@@ -0,0 +1,102 @@
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include "WS2812.h"
+#include "WS2812_symbols.h"
+
+// Cycles per pixel to turn GRB bytes into RMT symbols: the old encoder that
+// branched on every bit and filled each field, against copying eight
+// ready-made words per byte from the table the RMT translator uses
+
+#define PIXELS 256
+#define FRAMES 100
+
+// Layout of the RMT driver's rmt_item32_t
+typedef union {
+    struct {
+        uint32_t duration0 : 15;
+        uint32_t level0 : 1;
+        uint32_t duration1 : 15;
+        uint32_t level1 : 1;
+    };
+    uint32_t val;
+} rmt_item32_t;
+
+static uint8_t frame[PIXELS * 3];
+static rmt_item32_t branchy[PIXELS * 3 * 8];
+static rmt_item32_t table[PIXELS * 3 * 8];
+
+void setUp(void) {
+    for (int i = 0; i < PIXELS * 3; i++) {
+        frame[i] = (uint8_t)(i * 37 + 11);
+    }
+}
+
+void tearDown(void) {
+}
+
+static void write_byte(rmt_item32_t *item, uint8_t byte) {
+    for (int bit = 7; bit >= 0; bit--) {
+        if (byte & (1 << bit)) {
+            item->level0 = 1;
+            item->duration0 = WS2812_T1H_NS / 25;
+            item->level1 = 0;
+            item->duration1 = WS2812_T1L_NS / 25;
+        } else {
+            item->level0 = 1;
+            item->duration0 = WS2812_T0H_NS / 25;
+            item->level1 = 0;
+            item->duration1 = WS2812_T0L_NS / 25;
+        }
+        item++;
+    }
+}
+
+static void encode_branchy(void) {
+    rmt_item32_t *item = branchy;
+    for (int i = 0; i < PIXELS * 3; i++, item += 8) {
+        write_byte(item, frame[i]);
+    }
+}
+
+// The RMT translator's inner loop
+static void encode_table(void) {
+    rmt_item32_t *dest = table;
+    for (int i = 0; i < PIXELS * 3; i++, dest += 8) {
+        const uint32_t *symbols = ws2812_symbol_lut[frame[i]];
+        for (int bit = 0; bit < 8; bit++) {
+            dest[bit].val = symbols[bit];
+        }
+    }
+}
+
+static uint32_t cycles_per_pixel(void (*encode)(void)) {
+    encode();
+    uint32_t start = esp_cpu_get_cycle_count();
+    for (int f = 0; f < FRAMES; f++) {
+        encode();
+    }
+    return (esp_cpu_get_cycle_count() - start) / (FRAMES * PIXELS);
+}
+
+static void report(const char *name, uint32_t cycles) {
+    char line[64];
+    snprintf(line, sizeof(line), "%-8s %4u cycles/pixel", name, (unsigned)cycles);
+    TEST_MESSAGE(line);
+}
+
+static void test_bench_branchy_vs_table_encoder(void) {
+    report("branchy", cycles_per_pixel(encode_branchy));
+    report("table", cycles_per_pixel(encode_table));
+
+    // Both put the same symbols on the wire
+    TEST_ASSERT_EQUAL_MEMORY(branchy, table, sizeof(table));
+}
+
+int main(int argc, char **argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_bench_branchy_vs_table_encoder);
+    return UNITY_END();
+}
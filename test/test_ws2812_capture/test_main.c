@@ -0,0 +1,217 @@
+#include <unity.h>
+#include "WS2812.h"
+#include "WS2812_symbols.h"
+
+// Frames the WS2812 driver sends, checked through the capture transport
+
+#define PIXELS 16
+
+static ws2812_t *strip;
+
+void setUp(void) {
+    strip = ws2812_init_capture(PIXELS);
+}
+
+void tearDown(void) {
+    ws2812_free(strip);
+    strip = NULL;
+}
+
+static void test_first_frame_sends_every_pixel_in_grb_order(void) {
+    ws2812_set_pixel(strip, 0, 10, 20, 30);
+    ws2812_show(strip);
+
+    const ws2812_capture_t *capture = ws2812_get_capture(strip);
+    TEST_ASSERT_NOT_NULL(capture);
+    TEST_ASSERT_EQUAL(1, capture->frames);
+    TEST_ASSERT_EQUAL(PIXELS * 3, capture->len);
+    const uint8_t grb[] = {20, 10, 30, 0, 0, 0};
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(grb, capture->bytes, sizeof(grb));
+}
+
+static void test_unchanged_frame_is_skipped(void) {
+    ws2812_set_pixel(strip, 3, 255, 0, 0);
+    ws2812_show(strip);
+    ws2812_set_pixel(strip, 3, 255, 0, 0);
+    ws2812_show(strip);
+    ws2812_show(strip);
+
+    ws2812_stats_t stats;
+    ws2812_get_stats(strip, &stats);
+    TEST_ASSERT_EQUAL(1, ws2812_get_capture(strip)->frames);
+    TEST_ASSERT_EQUAL(1, stats.frames);
+    TEST_ASSERT_EQUAL(2, stats.skipped_frames);
+}
+
+static void count_done(ws2812_t *done_strip, void *arg) {
+    (void)done_strip;
+    (*(int*)arg)++;
+}
+
+static void test_skipped_frame_still_notifies(void) {
+    int done = 0;
+    ws2812_set_done_callback(strip, count_done, &done);
+    ws2812_show_async(strip);
+    TEST_ASSERT_EQUAL(1, done);
+    ws2812_show_async(strip);
+    TEST_ASSERT_EQUAL(2, done);
+    TEST_ASSERT_EQUAL(1, ws2812_get_capture(strip)->frames);
+}
+
+static void test_force_refresh_resends_unchanged_frame(void) {
+    ws2812_show(strip);
+    ws2812_force_refresh(strip);
+    ws2812_show(strip);
+
+    const ws2812_capture_t *capture = ws2812_get_capture(strip);
+    TEST_ASSERT_EQUAL(2, capture->frames);
+    TEST_ASSERT_EQUAL(PIXELS * 3, capture->len);
+}
+
+static void test_only_changed_prefix_is_sent(void) {
+    ws2812_show(strip);
+    ws2812_set_pixel(strip, 2, 1, 2, 3);
+    ws2812_set_pixel(strip, 9, 4, 5, 6);
+    ws2812_show(strip);
+
+    const ws2812_capture_t *capture = ws2812_get_capture(strip);
+    TEST_ASSERT_EQUAL(2, capture->frames);
+    TEST_ASSERT_EQUAL(10 * 3, capture->len);
+
+    ws2812_stats_t stats;
+    ws2812_get_stats(strip, &stats);
+    TEST_ASSERT_EQUAL(10, stats.last_sent_pixels);
+
+    // Rewriting a pixel with its current colour changes nothing on the wire
+    ws2812_set_pixel(strip, 12, 0, 0, 0);
+    ws2812_set_pixel(strip, 2, 7, 7, 7);
+    ws2812_show(strip);
+    TEST_ASSERT_EQUAL(3, capture->frames);
+    TEST_ASSERT_EQUAL(3 * 3, capture->len);
+}
+
+static void test_brightness_scales_every_channel(void) {
+    ws2812_set_brightness(strip, 128);
+    ws2812_set_pixel(strip, 0, 255, 100, 1);
+    ws2812_show(strip);
+
+    // value * 128 / 255, rounded, with lit channels never dropping to black
+    const uint8_t grb[] = {50, 128, 1};
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(grb, ws2812_get_capture(strip)->bytes, sizeof(grb));
+
+    // A brightness change alone re-encodes and resends the frame
+    ws2812_set_brightness(strip, 64);
+    ws2812_show(strip);
+    const uint8_t dimmer[] = {25, 64, 1};
+    TEST_ASSERT_EQUAL(2, ws2812_get_capture(strip)->frames);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(dimmer, ws2812_get_capture(strip)->bytes, sizeof(dimmer));
+}
+
+static void test_current_limit_scales_frame_down(void) {
+    // 16 LEDs idle at 16 mA; full white on all of them is about 976 mA
+    ws2812_set_current_limit(strip, 16 + 480);
+    for (int i = 0; i < PIXELS; i++) {
+        ws2812_set_pixel(strip, i, 255, 255, 255);
+    }
+    ws2812_show(strip);
+
+    ws2812_stats_t stats;
+    ws2812_get_stats(strip, &stats);
+    TEST_ASSERT_EQUAL(1, stats.limited_frames);
+    TEST_ASSERT_INT_WITHIN(2, 127, ws2812_get_capture(strip)->bytes[0]);
+}
+
+static void test_unlimited_frame_still_reports_current(void) {
+    // No limit, so the estimate is made when the stats are read
+    for (int i = 0; i < PIXELS; i++) {
+        ws2812_set_pixel(strip, i, 255, 255, 255);
+    }
+    ws2812_show(strip);
+
+    ws2812_stats_t stats;
+    ws2812_get_stats(strip, &stats);
+    TEST_ASSERT_EQUAL(0, stats.limited_frames);
+    TEST_ASSERT_EQUAL(ws2812_estimate_current(strip), stats.current_ma);
+    TEST_ASSERT_INT_WITHIN(16, 976, stats.current_ma);
+}
+
+static void test_current_limit_below_idle_draw_blanks_frame(void) {
+    // The limit cannot even cover the LEDs' idle draw
+    ws2812_set_current_limit(strip, PIXELS / 2);
+    ws2812_show(strip);
+    ws2812_set_pixel(strip, 0, 1, 0, 0);
+    ws2812_show(strip);
+
+    const ws2812_capture_t *capture = ws2812_get_capture(strip);
+    for (size_t i = 0; i < PIXELS * 3; i++) {
+        TEST_ASSERT_EQUAL(0, capture->bytes[i]);
+    }
+}
+
+static void test_palette_swap_recolours_without_redraw(void) {
+    ws2812_set_format(strip, WS2812_FORMAT_PALETTE);
+    TEST_ASSERT_NOT_NULL(strip->palette);
+    ws2812_set_palette(strip, 1, 0, 0, 200);
+    ws2812_set_pixel_index(strip, 4, 1);
+    ws2812_show(strip);
+
+    const ws2812_capture_t *capture = ws2812_get_capture(strip);
+    const uint8_t blue[] = {0, 0, 200};
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(blue, capture->bytes + 4 * 3, sizeof(blue));
+
+    ws2812_set_palette(strip, 1, 200, 0, 0);
+    ws2812_show(strip);
+    const uint8_t red[] = {0, 200, 0};
+    TEST_ASSERT_EQUAL(2, capture->frames);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(red, capture->bytes + 4 * 3, sizeof(red));
+
+    // Leaving palette format keeps the picture and drops the palette
+    ws2812_set_format(strip, WS2812_FORMAT_RGB);
+    TEST_ASSERT_NULL(strip->palette);
+    TEST_ASSERT_EQUAL(200, ws2812_get_pixel(strip, 4).r);
+    ws2812_show(strip);
+    TEST_ASSERT_EQUAL(2, capture->frames);
+}
+
+static void test_symbols_follow_the_rmt_table(void) {
+    ws2812_set_pixel(strip, 0, 0x00, 0xA5, 0xFF);
+    ws2812_show(strip);
+
+    const ws2812_capture_t *capture = ws2812_get_capture(strip);
+    TEST_ASSERT_EQUAL(PIXELS * 3 * 8, capture->symbol_count);
+
+    // G = 0xA5: 1 0 1 0 0 1 0 1, MSB first
+    const ws2812_symbol_t *symbol = capture->symbols;
+    for (int bit = 0; bit < 8; bit++, symbol++) {
+        bool one = 0xA5 & (0x80 >> bit);
+        TEST_ASSERT_EQUAL(one ? WS2812_T1H_NS : WS2812_T0H_NS, symbol->high_ns);
+        TEST_ASSERT_EQUAL(one ? WS2812_T1L_NS : WS2812_T0L_NS, symbol->low_ns);
+    }
+
+    // Every captured symbol is the table's symbol for its byte
+    for (size_t i = 0; i < capture->len; i++) {
+        for (int bit = 0; bit < 8; bit++) {
+            ws2812_symbol_t expected = ws2812_symbol_decode(ws2812_symbol_lut[capture->bytes[i]][bit]);
+            TEST_ASSERT_EQUAL(expected.high_ns, capture->symbols[i * 8 + bit].high_ns);
+            TEST_ASSERT_EQUAL(expected.low_ns, capture->symbols[i * 8 + bit].low_ns);
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_first_frame_sends_every_pixel_in_grb_order);
+    RUN_TEST(test_unchanged_frame_is_skipped);
+    RUN_TEST(test_skipped_frame_still_notifies);
+    RUN_TEST(test_force_refresh_resends_unchanged_frame);
+    RUN_TEST(test_only_changed_prefix_is_sent);
+    RUN_TEST(test_brightness_scales_every_channel);
+    RUN_TEST(test_current_limit_scales_frame_down);
+    RUN_TEST(test_unlimited_frame_still_reports_current);
+    RUN_TEST(test_current_limit_below_idle_draw_blanks_frame);
+    RUN_TEST(test_palette_swap_recolours_without_redraw);
+    RUN_TEST(test_symbols_follow_the_rmt_table);
+    return UNITY_END();
+}